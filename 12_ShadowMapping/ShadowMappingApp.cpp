@@ -149,15 +149,8 @@ void ShadowMappingApp::OnUpdate()
 		m_lightNear,
 		m_lightFar);
 
-	for (auto& mesh : m_skinningAnimMeshes)
-	{
-		mesh.Update(MyTime::DeltaTime());
-	}
-
-	for (auto& mesh : m_rigidAnimMeshes)
-	{
-		mesh.Update(MyTime::DeltaTime());
-	}
+	SkeletalMesh::UpdateAll(m_skinningAnimMeshes, MyTime::DeltaTime());
+	SkeletalMesh::UpdateAll(m_rigidAnimMeshes, MyTime::DeltaTime());
 }
 
 void ShadowMappingApp::OnRender()
@@ -171,6 +164,8 @@ void ShadowMappingApp::OnRender()
 		m_camera.GetNear(),
 		m_camera.GetFar());
 
+	CullScene();
+
 	// draw
 	auto deviceContext = m_graphicsDevice.GetDeviceContext();
 	auto renderTargetView = m_graphicsDevice.GetRenderTargetView();
@@ -270,6 +265,45 @@ void ShadowMappingApp::OnShutdown()
 	Material::DestroyDefaultTextureSRV();
 }
 
+void ShadowMappingApp::CullScene()
+{
+	m_staticMeshCuller.Clear();
+	for (const auto& mesh : m_staticMeshes)
+	{
+		mesh.CalculateWorldBounds(m_sectionBounds);
+		m_staticMeshCuller.AddMesh(m_sectionBounds);
+	}
+
+	m_rigidAnimMeshCuller.Clear();
+	for (const auto& mesh : m_rigidAnimMeshes)
+	{
+		mesh.CalculateWorldBounds(m_sectionBounds);
+		m_rigidAnimMeshCuller.AddMesh(m_sectionBounds);
+	}
+
+	m_skinningAnimMeshCuller.Clear();
+	for (const auto& mesh : m_skinningAnimMeshes)
+	{
+		mesh.CalculateWorldBounds(m_sectionBounds);
+		m_skinningAnimMeshCuller.AddMesh(m_sectionBounds);
+	}
+
+	DirectX::BoundingFrustum cameraFrustum(m_projection);
+	cameraFrustum.Transform(cameraFrustum, m_view.Invert());
+
+	m_staticMeshCuller.Cull(cameraFrustum, m_cameraVisibleStaticMeshes);
+	m_rigidAnimMeshCuller.Cull(cameraFrustum, m_cameraVisibleRigidAnimMeshes);
+	m_skinningAnimMeshCuller.Cull(cameraFrustum, m_cameraVisibleSkinningAnimMeshes);
+
+	//   Ʈ ü ȸ Ƿ ۿ ִ ĳʹ ׷ ǹ 
+	DirectX::BoundingFrustum lightFrustum(m_lightProjection);
+	lightFrustum.Transform(lightFrustum, m_lightView.Invert());
+
+	m_staticMeshCuller.Cull(lightFrustum, m_lightVisibleStaticMeshes);
+	m_rigidAnimMeshCuller.Cull(lightFrustum, m_lightVisibleRigidAnimMeshes);
+	m_skinningAnimMeshCuller.Cull(lightFrustum, m_lightVisibleSkinningAnimMeshes);
+}
+
 void ShadowMappingApp::RenderShadowMap()
 {
 	auto deviceContext = m_graphicsDevice.GetDeviceContext();
@@ -286,16 +320,19 @@ void ShadowMappingApp::RenderShadowMap()
 	deviceContext->IASetInputLayout(m_commonInputLayout.Get());
 	deviceContext->VSSetShader(m_basicLightViewVS.Get(), nullptr, 0);
 
-	for (const auto& staticMesh : m_staticMeshes)
+	for (const auto& visibleMesh : m_lightVisibleStaticMeshes.meshes)
 	{
+		const auto& staticMesh = m_staticMeshes[visibleMesh.meshIndex];
 		const auto& meshes = staticMesh.GetMeshes();
 		const auto& materials = staticMesh.GetMaterials();
 
 		worldtransformBuffer.world = staticMesh.GetWorld().Transpose();
 		deviceContext->UpdateSubresource(m_worldTransformCB.Get(), 0, nullptr, &worldtransformBuffer, 0, 0);
 
-		for (const auto& mesh : meshes)
+		for (std::uint32_t i = 0; i < visibleMesh.sectionCount; ++i)
 		{
+			const auto& mesh = meshes[m_lightVisibleStaticMeshes.sectionIndices[visibleMesh.firstSection + i]];
+
 			auto textureSRV = materials[mesh.GetMaterialIndex()].GetTextureSRVs().opacityTextureSRV;
 
 			deviceContext->PSSetShaderResources(0, 1, textureSRV.GetAddressOf());
@@ -311,8 +348,9 @@ void ShadowMappingApp::RenderShadowMap()
 	deviceContext->IASetInputLayout(m_commonInputLayout.Get());
 	deviceContext->VSSetShader(m_rigidAnimLightViewVS.Get(), nullptr, 0);
 
-	for (const auto& skeletalMesh : m_rigidAnimMeshes)
+	for (const auto& visibleMesh : m_lightVisibleRigidAnimMeshes.meshes)
 	{
+		const auto& skeletalMesh = m_rigidAnimMeshes[visibleMesh.meshIndex];
 		const auto& meshes = skeletalMesh.GetMeshes();
 		const auto& materials = skeletalMesh.GetMaterials();
 
@@ -320,8 +358,10 @@ void ShadowMappingApp::RenderShadowMap()
 
 		worldtransformBuffer.world = skeletalMesh.GetWorld().Transpose();
 
-		for (const auto& mesh : meshes)
+		for (std::uint32_t i = 0; i < visibleMesh.sectionCount; ++i)
 		{
+			const auto& mesh = meshes[m_lightVisibleRigidAnimMeshes.sectionIndices[visibleMesh.firstSection + i]];
+
 			worldtransformBuffer.refBoneIndex = mesh.GetBoneReference();
 			deviceContext->UpdateSubresource(m_worldTransformCB.Get(), 0, nullptr, &worldtransformBuffer, 0, 0);
 
@@ -340,8 +380,9 @@ void ShadowMappingApp::RenderShadowMap()
 	deviceContext->IASetInputLayout(m_skinningInputLayout.Get());
 	deviceContext->VSSetShader(m_skinningAnimLightViewVS.Get(), nullptr, 0);
 
-	for (const auto& skeletalMesh : m_skinningAnimMeshes)
+	for (const auto& visibleMesh : m_lightVisibleSkinningAnimMeshes.meshes)
 	{
+		const auto& skeletalMesh = m_skinningAnimMeshes[visibleMesh.meshIndex];
 		const auto& meshes = skeletalMesh.GetMeshes();
 		const auto& materials = skeletalMesh.GetMaterials();
 
@@ -351,8 +392,10 @@ void ShadowMappingApp::RenderShadowMap()
 		worldtransformBuffer.world = skeletalMesh.GetWorld().Transpose();
 		deviceContext->UpdateSubresource(m_worldTransformCB.Get(), 0, nullptr, &worldtransformBuffer, 0, 0);
 
-		for (const auto& mesh : meshes)
+		for (std::uint32_t i = 0; i < visibleMesh.sectionCount; ++i)
 		{
+			const auto& mesh = meshes[m_lightVisibleSkinningAnimMeshes.sectionIndices[visibleMesh.firstSection + i]];
+
 			auto textureSRV = materials[mesh.GetMaterialIndex()].GetTextureSRVs().opacityTextureSRV;
 
 			deviceContext->PSSetShaderResources(0, 1, textureSRV.GetAddressOf());
@@ -399,16 +442,19 @@ void ShadowMappingApp::RenderFinal()
 	deviceContext->IASetInputLayout(m_commonInputLayout.Get());
 	deviceContext->VSSetShader(m_basicVS.Get(), nullptr, 0);
 
-	for (const auto& staticMesh : m_staticMeshes)
+	for (const auto& visibleMesh : m_cameraVisibleStaticMeshes.meshes)
 	{
+		const auto& staticMesh = m_staticMeshes[visibleMesh.meshIndex];
 		const auto& meshes = staticMesh.GetMeshes();
 		const auto& materials = staticMesh.GetMaterials();
 
 		worldtransformBuffer.world = staticMesh.GetWorld().Transpose();
 		deviceContext->UpdateSubresource(m_worldTransformCB.Get(), 0, nullptr, &worldtransformBuffer, 0, 0);
 
-		for (const auto& mesh : meshes)
+		for (std::uint32_t i = 0; i < visibleMesh.sectionCount; ++i)
 		{
+			const auto& mesh = meshes[m_cameraVisibleStaticMeshes.sectionIndices[visibleMesh.firstSection + i]];
+
 			auto textureSRVs = materials[mesh.GetMaterialIndex()].GetTextureSRVs().AsRawArray();
 
 			deviceContext->IASetVertexBuffers(0, 1, mesh.GetVertexBuffer().GetAddressOf(), &m_commonVertexBufferStride, &m_vertexBufferOffset);
@@ -423,8 +469,9 @@ void ShadowMappingApp::RenderFinal()
 	deviceContext->IASetInputLayout(m_commonInputLayout.Get());
 	deviceContext->VSSetShader(m_rigidAnimVS.Get(), nullptr, 0);
 
-	for (const auto& skeletalMesh : m_rigidAnimMeshes)
+	for (const auto& visibleMesh : m_cameraVisibleRigidAnimMeshes.meshes)
 	{
+		const auto& skeletalMesh = m_rigidAnimMeshes[visibleMesh.meshIndex];
 		const auto& meshes = skeletalMesh.GetMeshes();
 		const auto& materials = skeletalMesh.GetMaterials();
 
@@ -432,8 +479,10 @@ void ShadowMappingApp::RenderFinal()
 
 		worldtransformBuffer.world = skeletalMesh.GetWorld().Transpose();
 
-		for (const auto& mesh : meshes)
+		for (std::uint32_t i = 0; i < visibleMesh.sectionCount; ++i)
 		{
+			const auto& mesh = meshes[m_cameraVisibleRigidAnimMeshes.sectionIndices[visibleMesh.firstSection + i]];
+
 			worldtransformBuffer.refBoneIndex = mesh.GetBoneReference();
 			deviceContext->UpdateSubresource(m_worldTransformCB.Get(), 0, nullptr, &worldtransformBuffer, 0, 0);
 
@@ -451,8 +500,9 @@ void ShadowMappingApp::RenderFinal()
 	deviceContext->IASetInputLayout(m_skinningInputLayout.Get());
 	deviceContext->VSSetShader(m_skinningAnimVS.Get(), nullptr, 0);
 
-	for (const auto& skeletalMesh : m_skinningAnimMeshes)
+	for (const auto& visibleMesh : m_cameraVisibleSkinningAnimMeshes.meshes)
 	{
+		const auto& skeletalMesh = m_skinningAnimMeshes[visibleMesh.meshIndex];
 		const auto& meshes = skeletalMesh.GetMeshes();
 		const auto& materials = skeletalMesh.GetMaterials();
 
@@ -462,8 +512,10 @@ void ShadowMappingApp::RenderFinal()
 		worldtransformBuffer.world = skeletalMesh.GetWorld().Transpose();
 		deviceContext->UpdateSubresource(m_worldTransformCB.Get(), 0, nullptr, &worldtransformBuffer, 0, 0);
 
-		for (const auto& mesh : meshes)
+		for (std::uint32_t i = 0; i < visibleMesh.sectionCount; ++i)
 		{
+			const auto& mesh = meshes[m_cameraVisibleSkinningAnimMeshes.sectionIndices[visibleMesh.firstSection + i]];
+
 			auto textureSRVs = materials[mesh.GetMaterialIndex()].GetTextureSRVs().AsRawArray();
 
 			deviceContext->IASetVertexBuffers(0, 1, mesh.GetVertexBuffer().GetAddressOf(), &m_boneWeightVertexBufferStride, &m_vertexBufferOffset);
@@ -574,6 +626,12 @@ void ShadowMappingApp::RenderImGui()
 	ImGui::NewLine();
 	ImGui::SeparatorText("Info");
 	ImGui::Text("%d FPS", GetLastFPS());
+	ImGui::Text("Visible Sections: Camera %zu, Light %zu / %u",
+		m_cameraVisibleStaticMeshes.sectionIndices.size() + m_cameraVisibleRigidAnimMeshes.sectionIndices.size() +
+		m_cameraVisibleSkinningAnimMeshes.sectionIndices.size(),
+		m_lightVisibleStaticMeshes.sectionIndices.size() + m_lightVisibleRigidAnimMeshes.sectionIndices.size() +
+		m_lightVisibleSkinningAnimMeshes.sectionIndices.size(),
+		m_staticMeshCuller.GetSectionCount() + m_rigidAnimMeshCuller.GetSectionCount() + m_skinningAnimMeshCuller.GetSectionCount());
 	ImGui::Checkbox("Use Shadow PCF", &m_useShadowPCF);
 	ImGui::Image((ImTextureID)(intptr_t)m_shadowMapSRV.Get(), ImVec2(300.0f, 300.0f));
 	ImGui::End();
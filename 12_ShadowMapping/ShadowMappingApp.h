@@ -10,6 +10,8 @@
 #include <directxtk/PrimitiveBatch.h>
 #include <directxtk/VertexTypes.h>
 
+#include "../Common/VisibilityCuller.h"
+
 #include "StaticMesh.h"
 #include "SkeletalMesh.h"
 
@@ -66,6 +68,18 @@ private:
 	std::vector<SkeletalMesh> m_rigidAnimMeshes;
 	std::vector<SkeletalMesh> m_skinningAnimMeshes;
 
+	// ü ܰ. ޽ 迭 ÷ ϳ, н(ī޶, Ʈ) ̴  ϳ
+	VisibilityCuller m_staticMeshCuller;
+	VisibilityCuller m_rigidAnimMeshCuller;
+	VisibilityCuller m_skinningAnimMeshCuller;
+	VisibleList m_cameraVisibleStaticMeshes;
+	VisibleList m_cameraVisibleRigidAnimMeshes;
+	VisibleList m_cameraVisibleSkinningAnimMeshes;
+	VisibleList m_lightVisibleStaticMeshes;
+	VisibleList m_lightVisibleRigidAnimMeshes;
+	VisibleList m_lightVisibleSkinningAnimMeshes;
+	std::vector<DirectX::BoundingBox> m_sectionBounds;
+
 	// Debug Draw
 	using VertexType = DirectX::VertexPositionColor;
 
@@ -114,6 +128,7 @@ private:
 	void OnRender() override;
 	void OnShutdown() override;
 
+	void CullScene();
 	void RenderShadowMap();
 	void RenderFinal();
 	void RenderImGui();
@@ -10,6 +10,7 @@
 #include <functional>
 
 #include "../Common/Helper.h"
+#include "../Common/JobSystem.h"
 
 #include "SkeletalMeshSection.h"
 #include "Material.h"
@@ -137,6 +138,45 @@ bool SkeletalMesh::IsRigid() const
 	return m_isRigid;
 }
 
+void SkeletalMesh::CalculateWorldBounds(std::vector<DirectX::BoundingBox>& outSectionBounds) const
+{
+	const auto& meshes = m_resource->meshes;
+
+	outSectionBounds.resize(meshes.size());
+
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		const auto& mesh = meshes[i];
+
+		if (m_isRigid)
+		{
+			mesh.GetBounds().Transform(outSectionBounds[i], m_skeletonPose[mesh.GetBoneReference()].Transpose() * m_world);
+
+			continue;
+		}
+
+		// ġ    ̹Ƿ      
+		outSectionBounds[i] = DirectX::BoundingBox(m_world.Translation(), DirectX::SimpleMath::Vector3::Zero);
+
+		const auto& boneBoundsList = mesh.GetBoneBounds();
+
+		for (size_t j = 0; j < boneBoundsList.size(); ++j)
+		{
+			DirectX::BoundingBox bounds;
+			boneBoundsList[j].bounds.Transform(bounds, m_skeletonPose[boneBoundsList[j].boneIndex].Transpose() * m_world);
+
+			if (j == 0)
+			{
+				outSectionBounds[i] = bounds;
+			}
+			else
+			{
+				DirectX::BoundingBox::CreateMerged(outSectionBounds[i], outSectionBounds[i], bounds);
+			}
+		}
+	}
+}
+
 void SkeletalMesh::SetWorld(const Matrix& world) 
 {
 	m_world = world;
@@ -173,6 +213,18 @@ void SkeletalMesh::Update(float deltaTime)
 	}
 }
 
+void SkeletalMesh::UpdateAll(std::vector<SkeletalMesh>& meshes, float deltaTime)
+{
+	JobSystem::Get().ParallelFor(static_cast<std::uint32_t>(meshes.size()), JobSystem::DEFAULT_BATCH_SIZE,
+		[&meshes, deltaTime](std::uint32_t begin, std::uint32_t end)
+		{
+			for (std::uint32_t i = begin; i < end; ++i)
+			{
+				meshes[i].Update(deltaTime);
+			}
+		});
+}
+
 void SkeletalMesh::PlayAnimation(size_t index)
 {
 	m_animationIndex = index;
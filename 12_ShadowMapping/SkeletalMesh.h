@@ -4,6 +4,7 @@
 #include <vector>
 #include <directxtk/SimpleMath.h>
 #include <memory>
+#include <DirectXCollision.h>
 
 #include "SkeletalMeshSection.h"
 #include "Material.h"
@@ -41,10 +42,15 @@ public:
 	const BoneMatrixArray& GetSkeletonPose() const;
 	const BoneMatrixArray& GetBoneOffsets() const;
 	bool IsRigid() const;
+	//       AABB ä. Update ڿ ȣ
+	void CalculateWorldBounds(std::vector<DirectX::BoundingBox>& outSectionBounds) const;
 
 	void SetWorld(const Matrix& world);
 
 public:
 	void Update(float deltaTime);
+	// νϽ ϴ  б  ҽ̶ JobSystem  Update.
+	//  νϽ ̸ Ƶ m_skeletonPose 
+	static void UpdateAll(std::vector<SkeletalMesh>& meshes, float deltaTime);
 	void PlayAnimation(size_t index);
 };
\ No newline at end of file
@@ -51,16 +51,46 @@ SkeletalMeshSection::SkeletalMeshSection(const Microsoft::WRL::ComPtr<ID3D11Devi
 
 			const unsigned int boneIndex = skeletonInfo->GetBoneIndexByBoneName(boneName);
 
-			skeletonInfo->SetBoneOffset(DirectX::SimpleMath::Matrix(&bone->mOffsetMatrix.a1), boneIndex);
+			const DirectX::SimpleMath::Matrix offset(&bone->mOffsetMatrix.a1);
+			skeletonInfo->SetBoneOffset(offset, boneIndex);
 
 			m_boneReferences.push_back(boneIndex);
 
+			// aiMatrix ״ о ̴ ġ ̹Ƿ CPU   ٽ ġ
+			const DirectX::SimpleMath::Matrix boneSpace = offset.Transpose();
+			BoneBounds boneBounds{ boneIndex };
+			bool hasVertex = false;
+
 			for (unsigned int j = 0; j < bone->mNumWeights; ++j)
 			{
 				unsigned int vertexId = bone->mWeights[j].mVertexId;
 				float weight = bone->mWeights[j].mWeight;
 
 				vertices[vertexId].AddBoneData(boneIndex, weight);
+
+				if (weight <= 0.0f)
+				{
+					continue;
+				}
+
+				DirectX::BoundingBox point(
+					DirectX::SimpleMath::Vector3::Transform(vertices[vertexId].position, boneSpace),
+					DirectX::SimpleMath::Vector3::Zero);
+
+				if (hasVertex)
+				{
+					DirectX::BoundingBox::CreateMerged(boneBounds.bounds, boneBounds.bounds, point);
+				}
+				else
+				{
+					boneBounds.bounds = point;
+					hasVertex = true;
+				}
+			}
+
+			if (hasVertex)
+			{
+				m_boneBounds.push_back(boneBounds);
 			}
 		}
 
@@ -94,6 +124,8 @@ SkeletalMeshSection::SkeletalMeshSection(const Microsoft::WRL::ComPtr<ID3D11Devi
 
 		m_boneReference = skeletonInfo->GetBoneIndexByMeshName(m_name);
 
+		DirectX::BoundingBox::CreateFromPoints(m_bounds, numVertices, &vertices[0].position, sizeof(CommonVertex3D));
+
 		D3D11_BUFFER_DESC vertexBufferDesc{};
 		vertexBufferDesc.ByteWidth = static_cast<UINT>(sizeof(CommonVertex3D) * numVertices);
 		vertexBufferDesc.CPUAccessFlags = 0;
@@ -147,3 +179,13 @@ unsigned int SkeletalMeshSection::GetBoneReference() const
 {
 	return m_boneReference;
 }
+
+const DirectX::BoundingBox& SkeletalMeshSection::GetBounds() const
+{
+	return m_bounds;
+}
+
+const std::vector<BoneBounds>& SkeletalMeshSection::GetBoneBounds() const
+{
+	return m_boneBounds;
+}
@@ -4,10 +4,18 @@
 #include <string>
 #include <d3d11.h>
 #include <wrl/client.h>
+#include <DirectXCollision.h>
 
 struct aiMesh;
 class SkeletonInfo;
 
+struct BoneBounds
+{
+	unsigned int boneIndex;
+	//    ( )    ִ  AABB
+	DirectX::BoundingBox bounds;
+};
+
 class SkeletalMeshSection
 {
 private:
@@ -18,6 +26,10 @@ private:
 	unsigned int m_boneReference = 0;
 	unsigned int m_materialIndex;
 	UINT m_indexCount = 0;
+	// :     AABB
+	DirectX::BoundingBox m_bounds;
+	// Ű:  AABB   Űܼ ġ Ű׵  ׻ 
+	std::vector<BoneBounds> m_boneBounds;
 
 public:
 	SkeletalMeshSection(const Microsoft::WRL::ComPtr<ID3D11Device>& device, const aiMesh* mesh, SkeletonInfo* skeletonInfo, bool isRigid);
@@ -29,4 +41,6 @@ public:
 	unsigned int GetMaterialIndex() const;
 	const std::vector<unsigned int>& GetBoneReferences() const;
 	unsigned int GetBoneReference() const;
+	const DirectX::BoundingBox& GetBounds() const;
+	const std::vector<BoneBounds>& GetBoneBounds() const;
 };
\ No newline at end of file
@@ -59,6 +59,16 @@ const StaticMesh::Matrix& StaticMesh::GetWorld() const
 	return m_world;
 }
 
+void StaticMesh::CalculateWorldBounds(std::vector<DirectX::BoundingBox>& outSectionBounds) const
+{
+	outSectionBounds.resize(m_meshes.size());
+
+	for (size_t i = 0; i < m_meshes.size(); ++i)
+	{
+		m_meshes[i].GetBounds().Transform(outSectionBounds[i], m_world);
+	}
+}
+
 void StaticMesh::SetWorld(const Matrix& world)
 {
 	m_world = world;
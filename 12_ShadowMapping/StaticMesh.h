@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <directxtk/SimpleMath.h>
+#include <DirectXCollision.h>
 
 #include "StaticMeshSection.h"
 #include "Material.h"
@@ -28,6 +29,8 @@ public:
 	const std::vector<StaticMeshSection>& GetMeshes() const;
 	const std::vector<Material>& GetMaterials() const;
 	const Matrix& GetWorld() const;
+	//    AABB ä (VisibilityCuller::AddMesh Է)
+	void CalculateWorldBounds(std::vector<DirectX::BoundingBox>& outSectionBounds) const;
 
 	void SetWorld(const Matrix& world);
 };
\ No newline at end of file
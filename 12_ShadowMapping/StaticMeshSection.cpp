@@ -25,6 +25,8 @@ StaticMeshSection::StaticMeshSection(const Microsoft::WRL::ComPtr<ID3D11Device>&
 			&mesh->mBitangents[i].x);
 	}
 
+	DirectX::BoundingBox::CreateFromPoints(m_bounds, numVertices, &vertices[0].position, sizeof(CommonVertex3D));
+
 	for (unsigned int i = 0; i < numFaces; ++i)
 	{
 		indices.push_back(mesh->mFaces[i].mIndices[0]);
@@ -76,3 +78,8 @@ const unsigned int StaticMeshSection::GetMaterialIndex() const
 {
 	return m_materialIndex;
 }
+
+const DirectX::BoundingBox& StaticMeshSection::GetBounds() const
+{
+	return m_bounds;
+}
@@ -5,6 +5,7 @@
 #include <d3d11.h>
 #include <wrl/client.h>
 #include <directxtk/SimpleMath.h>
+#include <DirectXCollision.h>
 
 #include "../Common/Vertex.h"
 
@@ -18,6 +19,8 @@ private:
 	Microsoft::WRL::ComPtr<ID3D11Buffer> m_indexBuffer;
 	unsigned int m_materialIndex;
 	UINT m_indexCount = 0;
+	// ޽   AABB
+	DirectX::BoundingBox m_bounds;
 
 public:
 	StaticMeshSection(const Microsoft::WRL::ComPtr<ID3D11Device>& device, aiMesh* mesh);
@@ -27,4 +30,5 @@ public:
 	const Microsoft::WRL::ComPtr<ID3D11Buffer>& GetIndexBuffer() const;
 	const UINT GetIndexCount() const;
 	const unsigned int GetMaterialIndex() const;
+	const DirectX::BoundingBox& GetBounds() const;
 };
\ No newline at end of file
@@ -93,6 +93,7 @@ void BVHApp::OnUpdate()
 
 	
 	auto& info = *(m_cubeInfo.begin());
+	Vector3 prevPosition = info.position;
 	float speed = 25.0f;
 	if (Input::IsKeyHeld(DirectX::Keyboard::Keys::Up))
 	{
@@ -133,14 +134,19 @@ void BVHApp::OnUpdate()
 	if (m_changed)
 	{
 		info.aabb = DirectX::BoundingBox(info.position, info.scale * 0.5f + Vector3(0.1f));
-		m_bvh.ChangeAABB(info.bvhId, info.aabb);
-		if (m_currentMethodIndex == 0)
+
+		// fat AABB ȿ  Ʈ ǵ帮 
+		if (!m_bvh.ChangeAABB(info.bvhId, info.aabb, info.position - prevPosition))
+		{
+			++m_skippedUpdateCount;
+		}
+		else if (m_currentMethodIndex == 0)
 		{
-			m_bvh.FullyRebuild(false);
+			m_bvh.FullyRebuild(false, m_useParallelBuild);
 		}
 		else if (m_currentMethodIndex == 1)
 		{
-			m_bvh.FullyRebuild();
+			m_bvh.FullyRebuild(true, m_useParallelBuild);
 		}
 		else if (m_currentMethodIndex == 2)
 		{
@@ -155,6 +161,8 @@ void BVHApp::OnUpdate()
 			m_bvh.OptimizeObject(info.bvhId);
 		}
 
+		m_flatBVH.Build(m_bvh);
+
 		m_changed = false;
 	}
 }
@@ -170,6 +178,25 @@ void BVHApp::OnRender()
 		m_camera.GetNear(),
 		m_camera.GetFar());
 
+	// culling
+	DirectX::BoundingFrustum frustum(m_projection);
+	frustum.Transform(frustum, m_view.Invert());
+
+	if (m_useFlatBVH)
+	{
+		m_flatBVH.QueryFrustum(frustum, m_visibleObjects);
+
+		m_isPicked = m_flatBVH.Raycast(m_camera.GetPosition(), m_camera.GetForward(), m_camera.GetFar(), m_pickedObject, m_pickedDistance);
+	}
+	else
+	{
+		m_bvh.QueryFrustum(frustum, m_visibleObjects);
+
+		m_isPicked = m_bvh.Raycast(m_camera.GetPosition(), m_camera.GetForward(), m_camera.GetFar(), m_pickedObject, m_pickedDistance);
+	}
+
+	m_bvh.FindOverlappingPairs(m_overlappingPairs);
+
 	// draw
 	auto deviceContext = m_graphicsDevice.GetDeviceContext();
 	auto renderTargetView = m_graphicsDevice.GetRenderTargetView();
@@ -206,6 +233,17 @@ void BVHApp::OnRender()
 		DX::Draw(m_batch.get(), tr.aabb, DirectX::Colors::Red);
 	}
 
+	for (const auto& pair : m_overlappingPairs)
+	{
+		DX::Draw(m_batch.get(), m_cubeInfo[m_bvhIdToCubeIndex[pair.first]].aabb, DirectX::Colors::Orange);
+		DX::Draw(m_batch.get(), m_cubeInfo[m_bvhIdToCubeIndex[pair.second]].aabb, DirectX::Colors::Orange);
+	}
+
+	if (m_isPicked)
+	{
+		DX::Draw(m_batch.get(), m_cubeInfo[m_bvhIdToCubeIndex[m_pickedObject]].aabb, DirectX::Colors::Yellow);
+	}
+
 	const auto& nodes = m_bvh.GetNodes();
 
 	const int n = 20;
@@ -213,9 +251,25 @@ void BVHApp::OnRender()
 
 	const int step = 7;
 
+	//  ִ 尡  Ƿ Ʈ  常 ׸
+	std::vector<std::uint32_t> nodeStack;
+	if (m_bvh.GetRootIndex() != BVH::INVALID_INDEX)
+	{
+		nodeStack.push_back(m_bvh.GetRootIndex());
+	}
+
 	int i = 0;
-	for (const auto& node : nodes)
+	while (!nodeStack.empty())
 	{
+		const auto& node = nodes[nodeStack.back()];
+		nodeStack.pop_back();
+
+		if (!node.IsLeaf())
+		{
+			nodeStack.push_back(node.right);
+			nodeStack.push_back(node.left);
+		}
+
 		float r = 0.5f + 0.5f * std::sin(frequency * (i * step) + 0.0f);
 		float g = 0.5f + 0.5f * std::sin(frequency * (i * step) + 2.0f);
 		float b = 0.5f + 0.5f * std::sin(frequency * (i * step) + 4.0f);
@@ -258,8 +312,10 @@ void BVHApp::RenderFinal()
 	deviceContext->VSSetShader(m_cubeVertexShader->GetRawShader(), nullptr, 0);
 	deviceContext->PSSetShader(m_cubePixelShader->GetRawShader(), nullptr, 0);
 
-	for (auto& tr : m_cubeInfo)
+	for (auto objectId : m_visibleObjects)
 	{
+		const auto& tr = m_cubeInfo[m_bvhIdToCubeIndex[objectId]];
+
 		Matrix world = Matrix::CreateScale(tr.scale) * Matrix::CreateTranslation(tr.position);
 
 		simpleConstant.world = world.Transpose();
@@ -334,12 +390,82 @@ void BVHApp::RenderImGui()
 	ImGui::Text("+X: ArrowRight / -X: ArrowLeft");
 	ImGui::Text("+Z: ArrowUp / -Z: ArrowDown");
 	ImGui::Text("+Y: PageUp / -Y: PageDown");
-	const char* items[]{ "Fully rebuild(median)", "Fully rebuild(Full sweep SAH)", "Refit only", "Refit with rotation", "Remove/Insert"};
+	const char* items[]{ "Fully rebuild(median)", "Fully rebuild(Binned SAH)", "Refit only", "Refit with rotation", "Remove/Insert"};
 	if (ImGui::Combo("BVH Update Method", &m_currentMethodIndex, items, 5))
 	{
 		m_changed = true;
 	}
 
+	if (ImGui::Checkbox("Parallel Build", &m_useParallelBuild))
+	{
+		m_changed = true;
+	}
+
+	if (ImGui::SliderInt("Max Leaf Size", &m_maxLeafSize, 1, 8))
+	{
+		m_bvh.SetMaxLeafSize(m_maxLeafSize);
+		m_bvh.FullyRebuild(true, m_useParallelBuild);
+		m_flatBVH.Build(m_bvh);
+	}
+
+	if (ImGui::SliderFloat("Fat AABB Margin", &m_fatAABBMargin, 0.0f, 3.0f))
+	{
+		m_bvh.SetFatAABBMargin(m_fatAABBMargin);
+		m_bvh.FullyRebuild(true, m_useParallelBuild);
+		m_flatBVH.Build(m_bvh);
+	}
+
+	ImGui::Checkbox("Query with FlatBVH(BVH4)", &m_useFlatBVH);
+
+	if (ImGui::Button("Add Cube"))
+	{
+		float areaSize = 20.0f;
+		float maxCubeSize = 3.0f;
+		Vector3 position{ RandomFloat(-areaSize, areaSize), RandomFloat(-areaSize, areaSize), RandomFloat(-areaSize, areaSize) };
+		Vector3 scale{ RandomFloat(1, maxCubeSize), RandomFloat(1, maxCubeSize), RandomFloat(1, maxCubeSize) };
+		DirectX::BoundingBox aabb{ position, 0.5f * scale + Vector3(0.1f) };
+
+		std::uint32_t id = m_bvh.Insert(aabb);
+
+		m_bvhIdToCubeIndex[id] = static_cast<std::uint32_t>(m_cubeInfo.size());
+		m_cubeInfo.push_back({ position, scale, aabb, id });
+
+		m_flatBVH.Build(m_bvh);
+	}
+
+	ImGui::SameLine();
+
+	// 0 ť Ű ̴ ť ܵ
+	if (ImGui::Button("Remove Cube") && m_cubeInfo.size() > 1)
+	{
+		std::uint32_t id = m_cubeInfo.back().bvhId;
+
+		m_bvh.Remove(id);
+		m_bvhIdToCubeIndex.erase(id);
+		m_cubeInfo.pop_back();
+
+		m_flatBVH.Build(m_bvh);
+		m_isPicked = false;
+	}
+
+	//  ̶   FlatBVH ؼ   ٷ . ť갡 ̸ ٽ Build 
+	if (ImGui::Button("Save FlatBVH"))
+	{
+		m_flatBVH.Save(L"BVHCache.bvh");
+	}
+
+	ImGui::SameLine();
+
+	if (ImGui::Button("Load Mapped FlatBVH"))
+	{
+		if (!m_flatBVH.LoadMapped(L"BVHCache.bvh"))
+		{
+			m_flatBVH.Build(m_bvh);
+		}
+
+		m_isPicked = false;
+	}
+
 	ImGui::NewLine();
 
 	ImGui::SeparatorText("Light");
@@ -359,6 +485,21 @@ void BVHApp::RenderImGui()
 	ImGui::NewLine();
 	ImGui::SeparatorText("Info");
 	ImGui::Text("%d FPS", GetLastFPS());
+	ImGui::Text("BVH Nodes: %u (Depth %u)", m_bvh.GetNodeCount(), m_bvh.CalculateMaxDepth());
+	ImGui::Text("BVH SAH Cost: %.2f", m_bvh.CalculateSAHCost());
+	ImGui::Text("FlatBVH Nodes: %u (%s)", m_flatBVH.GetNodeCount(), m_flatBVH.IsMapped() ? "Mapped" : "Built");
+	ImGui::Text("Skipped BVH Updates: %u", m_skippedUpdateCount);
+	ImGui::Text("Overlapping Pairs: %d", static_cast<int>(m_overlappingPairs.size()));
+	ImGui::Text("Visible Cubes: %d / %d", static_cast<int>(m_visibleObjects.size()), static_cast<int>(m_cubeInfo.size()));
+
+	if (m_isPicked)
+	{
+		ImGui::Text("Picked: %u (%.2f)", m_pickedObject, m_pickedDistance);
+	}
+	else
+	{
+		ImGui::Text("Picked: None");
+	}
 
 	ImGui::End();
 
@@ -470,10 +611,15 @@ void BVHApp::InitializeScene()
 
 		auto ids = m_bvh.Insert(aabbs);
 
+		m_bvhIdToCubeIndex.reserve(ids.size());
+
 		for (size_t i = 0; i < ids.size(); ++i)
 		{
 			m_cubeInfo[i].bvhId = ids[i];
+			m_bvhIdToCubeIndex[ids[i]] = static_cast<std::uint32_t>(i);
 		}
+
+		m_flatBVH.Build(m_bvh);
 	}
 }
 
@@ -6,6 +6,7 @@
 #include <d3d11.h>
 #include <directxtk/SimpleMath.h>
 #include <memory>
+#include <unordered_map>
 #include <directxtk/CommonStates.h>
 #include <directxtk/Effects.h>
 #include <directxtk/PrimitiveBatch.h>
@@ -13,7 +14,8 @@
 
 #include "../Common/ConstantBuffer.h"
 
-#include "BVH.h"
+#include "../Common/BVH.h"
+#include "FlatBVH.h"
 
 class VertexBuffer;
 class IndexBuffer;
@@ -66,8 +68,21 @@ private:
 
 	UINT m_indexCount = 0;
 	BVH m_bvh;
+	FlatBVH m_flatBVH;
+	bool m_useFlatBVH = true;
 	int m_currentMethodIndex = 0;
 	bool m_changed = false;
+	bool m_useParallelBuild = false;
+	int m_maxLeafSize = 1;
+	float m_fatAABBMargin = 0.0f;
+	std::uint32_t m_skippedUpdateCount = 0;
+
+	std::vector<std::uint32_t> m_visibleObjects;
+	std::vector<BVH::ObjectPair> m_overlappingPairs;
+	std::unordered_map<std::uint32_t, std::uint32_t> m_bvhIdToCubeIndex;
+	std::uint32_t m_pickedObject = 0;
+	float m_pickedDistance = 0.0f;
+	bool m_isPicked = false;
 
 public:
 	void Initialize() override;
@@ -0,0 +1,639 @@
+// â/D3D  BVH ϴ ġũ ( CI )
+// : BVHBenchmark [--sizes 1000,10000,100000] [--frames 10] [--queries 10000] [--seed 1]
+// Ʈ  ˻, Ǵ  /FlatBVH    BVH ٸ 1 ȯ
+
+#include "../../Common/BVH.h"
+#include "../FlatBVH.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using DirectX::BoundingBox;
+using DirectX::XMFLOAT3;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	volatile std::size_t s_querySink = 0;
+
+	double ElapsedMs(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	struct Options
+	{
+		std::vector<std::uint32_t> sizes{ 1000, 10000, 100000 };
+		std::uint32_t frames = 10;
+		std::uint32_t queries = 10000;
+		std::uint32_t seed = 1;
+	};
+
+	struct Scene
+	{
+		const char* name;
+		float extent;
+		std::vector<BoundingBox> boxes;
+		std::vector<XMFLOAT3> velocities;
+		// Ӹ ̴ Ʈ 
+		float movingRatio;
+	};
+
+	enum class Strategy
+	{
+		MedianRebuild,
+		SAHRebuild,
+		Refit,
+		RefitWithRotation,
+		Reinsert,
+		Count
+	};
+
+	const char* STRATEGY_NAMES[] = { "median rebuild", "SAH rebuild", "refit", "refit+rotation", "reinsert" };
+
+	float RandomRange(std::mt19937& rng, float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(rng);
+	}
+
+	XMFLOAT3 RandomDirection(std::mt19937& rng)
+	{
+		XMFLOAT3 v{ RandomRange(rng, -1.0f, 1.0f), RandomRange(rng, -1.0f, 1.0f), RandomRange(rng, -1.0f, 1.0f) };
+		float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+
+		if (length < 1e-4f)
+		{
+			return { 1.0f, 0.0f, 0.0f };
+		}
+
+		return { v.x / length, v.y / length, v.z / length };
+	}
+
+	// е 뷫     ũ⸦ 
+	float SceneExtent(std::uint32_t count)
+	{
+		return 10.0f * std::cbrt(static_cast<float>(count));
+	}
+
+	Scene MakeUniformScene(std::uint32_t count, std::mt19937& rng)
+	{
+		Scene scene{ "uniform", SceneExtent(count) };
+
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			XMFLOAT3 center{ RandomRange(rng, -scene.extent, scene.extent), RandomRange(rng, -scene.extent, scene.extent), RandomRange(rng, -scene.extent, scene.extent) };
+			XMFLOAT3 extents{ RandomRange(rng, 0.5f, 2.0f), RandomRange(rng, 0.5f, 2.0f), RandomRange(rng, 0.5f, 2.0f) };
+
+			scene.boxes.push_back({ center, extents });
+			scene.velocities.push_back(RandomDirection(rng));
+		}
+
+		scene.movingRatio = 0.1f;
+
+		return scene;
+	}
+
+	//     ִ  (߾Ӱ  Ҹ )
+	Scene MakeClusteredScene(std::uint32_t count, std::mt19937& rng)
+	{
+		Scene scene{ "clustered", SceneExtent(count) };
+
+		std::uint32_t clusterCount = std::max(1u, static_cast<std::uint32_t>(std::sqrt(static_cast<float>(count)) / 4.0f));
+
+		std::vector<XMFLOAT3> clusterCenters;
+		for (std::uint32_t i = 0; i < clusterCount; ++i)
+		{
+			clusterCenters.push_back({ RandomRange(rng, -scene.extent, scene.extent), RandomRange(rng, -scene.extent, scene.extent), RandomRange(rng, -scene.extent, scene.extent) });
+		}
+
+		std::normal_distribution<float> spread(0.0f, scene.extent * 0.02f);
+
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			const auto& c = clusterCenters[rng() % clusterCount];
+			XMFLOAT3 center{ c.x + spread(rng), c.y + spread(rng), c.z + spread(rng) };
+			XMFLOAT3 extents{ RandomRange(rng, 0.2f, 1.0f), RandomRange(rng, 0.2f, 1.0f), RandomRange(rng, 0.2f, 1.0f) };
+
+			scene.boxes.push_back({ center, extents });
+			scene.velocities.push_back(RandomDirection(rng));
+		}
+
+		scene.movingRatio = 0.1f;
+
+		return scene;
+	}
+
+	//     ڽ (SAH ߾Ӱ ̰ ũ  )
+	Scene MakeLongThinScene(std::uint32_t count, std::mt19937& rng)
+	{
+		Scene scene{ "long-thin", SceneExtent(count) };
+
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			XMFLOAT3 center{ RandomRange(rng, -scene.extent, scene.extent), RandomRange(rng, -scene.extent, scene.extent), RandomRange(rng, -scene.extent, scene.extent) };
+			XMFLOAT3 extents{ 0.1f, 0.1f, 0.1f };
+			(&extents.x)[rng() % 3] = RandomRange(rng, scene.extent * 0.05f, scene.extent * 0.2f);
+
+			scene.boxes.push_back({ center, extents });
+			scene.velocities.push_back(RandomDirection(rng));
+		}
+
+		scene.movingRatio = 0.1f;
+
+		return scene;
+	}
+
+	// ΰ   귯  (   )
+	Scene MakeCrowdScene(std::uint32_t count, std::mt19937& rng)
+	{
+		Scene scene{ "moving crowd", SceneExtent(count) };
+
+		XMFLOAT3 flow = RandomDirection(rng);
+
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			XMFLOAT3 center{ RandomRange(rng, -scene.extent, scene.extent), 0.0f, RandomRange(rng, -scene.extent, scene.extent) };
+			XMFLOAT3 extents{ 0.4f, 1.0f, 0.4f };
+			XMFLOAT3 jitter = RandomDirection(rng);
+
+			scene.boxes.push_back({ center, extents });
+			scene.velocities.push_back({ flow.x + 0.5f * jitter.x, 0.0f, flow.z + 0.5f * jitter.z });
+		}
+
+		scene.movingRatio = 1.0f;
+
+		return scene;
+	}
+
+	//   ڱ Ʈ,  θ ڽ δ θ  Ȯ
+	bool ValidateTree(const BVH& bvh)
+	{
+		const auto& nodes = bvh.GetNodes();
+		const auto& objectIndices = bvh.GetObjectIndices();
+		const auto& objectAABBs = bvh.GetObjectAABBs();
+
+		if (bvh.GetRootIndex() == BVH::INVALID_INDEX)
+		{
+			return true;
+		}
+
+		auto contains = [](const BoundingBox& outer, const BoundingBox& inner)
+			{
+				const float epsilon = 1e-3f;
+
+				return std::fabs(inner.Center.x - outer.Center.x) + inner.Extents.x <= outer.Extents.x + epsilon &&
+					std::fabs(inner.Center.y - outer.Center.y) + inner.Extents.y <= outer.Extents.y + epsilon &&
+					std::fabs(inner.Center.z - outer.Center.z) + inner.Extents.z <= outer.Extents.z + epsilon;
+			};
+
+		std::vector<std::uint32_t> stack{ bvh.GetRootIndex() };
+
+		while (!stack.empty())
+		{
+			std::uint32_t nodeIndex = stack.back();
+			stack.pop_back();
+
+			const auto& node = nodes[nodeIndex];
+
+			if (node.IsLeaf())
+			{
+				for (std::uint32_t i = 0; i < node.objectCount; ++i)
+				{
+					if (!contains(node.aabb, objectAABBs[objectIndices[node.firstObject + i]]))
+					{
+						return false;
+					}
+				}
+
+				continue;
+			}
+
+			for (std::uint32_t child : { node.left, node.right })
+			{
+				if (nodes[child].parent != static_cast<std::int32_t>(nodeIndex) || !contains(node.aabb, nodes[child].aabb))
+				{
+					return false;
+				}
+
+				stack.push_back(child);
+			}
+		}
+
+		return true;
+	}
+
+	struct Result
+	{
+		double buildMs;
+		double updateMs;
+		float sahCost;
+		std::uint32_t nodeCount;
+		std::uint32_t depth;
+		double aabbQueriesPerSec;
+		double raysPerSec;
+		bool isValid;
+	};
+
+	Result RunStrategy(const Scene& scene, Strategy strategy, const Options& options)
+	{
+		Result result{};
+
+		BVH bvh;
+		std::vector<BoundingBox> boxes = scene.boxes;
+
+		std::vector<std::uint32_t> ids = bvh.Insert(boxes);
+
+		// ߾Ӱ  ߾Ӱ ϰ  SAH Ʈ 
+		auto buildStart = Clock::now();
+		bvh.FullyRebuild(strategy != Strategy::MedianRebuild);
+		result.buildMs = ElapsedMs(buildStart);
+
+		std::mt19937 rng(options.seed);
+		std::uint32_t movingCount = std::max(1u, static_cast<std::uint32_t>(boxes.size() * scene.movingRatio));
+		const float deltaTime = 1.0f / 60.0f;
+		const float speed = 5.0f;
+
+		std::vector<std::uint32_t> moving(movingCount);
+		double totalUpdateMs = 0.0;
+
+		for (std::uint32_t frame = 0; frame < options.frames; ++frame)
+		{
+			//  Ʈ ð ġ   
+			for (std::uint32_t i = 0; i < movingCount; ++i)
+			{
+				std::uint32_t index = movingCount == boxes.size() ? i : static_cast<std::uint32_t>(rng() % boxes.size());
+				const auto& velocity = scene.velocities[index];
+
+				boxes[index].Center.x += velocity.x * speed * deltaTime;
+				boxes[index].Center.y += velocity.y * speed * deltaTime;
+				boxes[index].Center.z += velocity.z * speed * deltaTime;
+
+				moving[i] = index;
+			}
+
+			auto updateStart = Clock::now();
+
+			for (auto index : moving)
+			{
+				bvh.ChangeAABB(ids[index], boxes[index]);
+			}
+
+			switch (strategy)
+			{
+			case Strategy::MedianRebuild:
+				bvh.FullyRebuild(false);
+				break;
+			case Strategy::SAHRebuild:
+				bvh.FullyRebuild(true);
+				break;
+			case Strategy::Refit:
+				bvh.Refit();
+				break;
+			case Strategy::RefitWithRotation:
+				bvh.RefitWithRotation();
+				break;
+			case Strategy::Reinsert:
+				for (auto index : moving)
+				{
+					bvh.OptimizeObject(ids[index]);
+				}
+				break;
+			default:
+				break;
+			}
+
+			totalUpdateMs += ElapsedMs(updateStart);
+		}
+
+		result.updateMs = options.frames > 0 ? totalUpdateMs / options.frames : 0.0;
+		result.sahCost = bvh.CalculateSAHCost();
+		result.nodeCount = bvh.GetNodeCount();
+		result.depth = bvh.CalculateMaxDepth();
+		result.isValid = ValidateTree(bvh);
+
+		//   ũ⿡      
+		std::mt19937 queryRng(options.seed + 1);
+		std::vector<std::uint32_t> hits;
+		std::size_t hitCount = 0;
+
+		auto queryStart = Clock::now();
+		for (std::uint32_t i = 0; i < options.queries; ++i)
+		{
+			XMFLOAT3 center{ RandomRange(queryRng, -scene.extent, scene.extent), RandomRange(queryRng, -scene.extent, scene.extent), RandomRange(queryRng, -scene.extent, scene.extent) };
+			float size = scene.extent * 0.05f;
+
+			bvh.QueryAABB({ center, { size, size, size } }, hits);
+			hitCount += hits.size();
+		}
+		double queryMs = ElapsedMs(queryStart);
+		result.aabbQueriesPerSec = queryMs > 0.0 ? options.queries * 1000.0 / queryMs : 0.0;
+
+		auto rayStart = Clock::now();
+		for (std::uint32_t i = 0; i < options.queries; ++i)
+		{
+			XMFLOAT3 origin{ RandomRange(queryRng, -scene.extent, scene.extent), RandomRange(queryRng, -scene.extent, scene.extent), RandomRange(queryRng, -scene.extent, scene.extent) };
+			XMFLOAT3 direction = RandomDirection(queryRng);
+
+			std::uint32_t object;
+			float distance;
+			hitCount += bvh.Raycast(origin, direction, scene.extent * 4.0f, object, distance) ? 1 : 0;
+		}
+		double rayMs = ElapsedMs(rayStart);
+		result.raysPerSec = rayMs > 0.0 ? options.queries * 1000.0 / rayMs : 0.0;
+
+		//  ȭ  ʵ  
+		s_querySink = hitCount;
+
+		return result;
+	}
+
+	struct RayQuery
+	{
+		XMFLOAT3 origin;
+		XMFLOAT3 direction;
+	};
+
+	struct FlatResult
+	{
+		double serialBuildMs;
+		double parallelBuildMs;
+		double flatBuildMs;
+		double bvhAABBQueriesPerSec;
+		double flatAABBQueriesPerSec;
+		double bvhSphereQueriesPerSec;
+		double flatSphereQueriesPerSec;
+		double bvhRaysPerSec;
+		double flatRaysPerSec;
+		//   Ʈ FlatBVH  BVH   ´
+		bool isMatching;
+	};
+
+	template<typename Query>
+	double QueriesPerSec(std::uint32_t count, Query&& query)
+	{
+		auto start = Clock::now();
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			query(i);
+		}
+		double ms = ElapsedMs(start);
+
+		return ms > 0.0 ? count * 1000.0 / ms : 0.0;
+	}
+
+	bool SameObjects(std::vector<std::uint32_t>& a, std::vector<std::uint32_t>& b)
+	{
+		std::sort(a.begin(), a.end());
+		std::sort(b.begin(), b.end());
+
+		return a == b;
+	}
+
+	//   slab    ޶ Ÿ  ϰ,
+	// ʸ ¾ ִ Ÿ  ģ 츸 
+	bool SameRayHit(bool hitA, float distanceA, bool hitB, float distanceB, float maxDistance)
+	{
+		if (hitA && hitB)
+		{
+			return std::fabs(distanceA - distanceB) <= 1e-3f * std::max(1.0f, distanceA);
+		}
+
+		if (hitA != hitB)
+		{
+			return (hitA ? distanceA : distanceB) >= maxDistance * 0.999f;
+		}
+
+		return true;
+	}
+
+	//  SAH Ʈ /ķ ϰ FlatBVH Űܼ    
+	FlatResult RunFlatComparison(const Scene& scene, const Options& options)
+	{
+		FlatResult result{};
+		result.isMatching = true;
+
+		BVH serialBVH;
+		serialBVH.Insert(scene.boxes);
+
+		auto serialStart = Clock::now();
+		serialBVH.FullyRebuild(true, false);
+		result.serialBuildMs = ElapsedMs(serialStart);
+
+		BVH parallelBVH;
+		parallelBVH.Insert(scene.boxes);
+
+		auto parallelStart = Clock::now();
+		parallelBVH.FullyRebuild(true, true);
+		result.parallelBuildMs = ElapsedMs(parallelStart);
+
+		result.isMatching = ValidateTree(parallelBVH);
+
+		FlatBVH flatBVH;
+
+		auto flatStart = Clock::now();
+		flatBVH.Build(serialBVH);
+		result.flatBuildMs = ElapsedMs(flatStart);
+
+		//    ̸    Է ް 
+		std::mt19937 queryRng(options.seed + 2);
+		std::vector<BoundingBox> boxQueries(options.queries);
+		std::vector<DirectX::BoundingSphere> sphereQueries(options.queries);
+		std::vector<RayQuery> rayQueries(options.queries);
+		const float querySize = scene.extent * 0.05f;
+		const float rayLength = scene.extent * 4.0f;
+
+		for (std::uint32_t i = 0; i < options.queries; ++i)
+		{
+			XMFLOAT3 center{ RandomRange(queryRng, -scene.extent, scene.extent), RandomRange(queryRng, -scene.extent, scene.extent), RandomRange(queryRng, -scene.extent, scene.extent) };
+
+			boxQueries[i] = { center, { querySize, querySize, querySize } };
+			sphereQueries[i] = { center, querySize };
+			rayQueries[i] = { center, RandomDirection(queryRng) };
+		}
+
+		std::vector<std::uint32_t> hits;
+		std::size_t hitCount = 0;
+
+		result.bvhAABBQueriesPerSec = QueriesPerSec(options.queries, [&](std::uint32_t i) { serialBVH.QueryAABB(boxQueries[i], hits); hitCount += hits.size(); });
+		result.flatAABBQueriesPerSec = QueriesPerSec(options.queries, [&](std::uint32_t i) { flatBVH.QueryAABB(boxQueries[i], hits); hitCount += hits.size(); });
+		result.bvhSphereQueriesPerSec = QueriesPerSec(options.queries, [&](std::uint32_t i) { serialBVH.QuerySphere(sphereQueries[i], hits); hitCount += hits.size(); });
+		result.flatSphereQueriesPerSec = QueriesPerSec(options.queries, [&](std::uint32_t i) { flatBVH.QuerySphere(sphereQueries[i], hits); hitCount += hits.size(); });
+
+		auto bvhRay = [&](std::uint32_t i)
+			{
+				std::uint32_t object;
+				float distance;
+				hitCount += serialBVH.Raycast(rayQueries[i].origin, rayQueries[i].direction, rayLength, object, distance) ? 1 : 0;
+			};
+		auto flatRay = [&](std::uint32_t i)
+			{
+				std::uint32_t object;
+				float distance;
+				hitCount += flatBVH.Raycast(rayQueries[i].origin, rayQueries[i].direction, rayLength, object, distance) ? 1 : 0;
+			};
+
+		result.bvhRaysPerSec = QueriesPerSec(options.queries, bvhRay);
+		result.flatRaysPerSec = QueriesPerSec(options.queries, flatRay);
+
+		s_querySink = hitCount;
+
+		// ˻    . ڽ   Ʈ   min/max 񱳶  Ȯ ƾ 
+		std::vector<std::uint32_t> expected;
+		std::vector<std::uint32_t> actual;
+
+		for (std::uint32_t i = 0; i < options.queries && result.isMatching; ++i)
+		{
+			serialBVH.QueryAABB(boxQueries[i], expected);
+
+			parallelBVH.QueryAABB(boxQueries[i], actual);
+			result.isMatching = SameObjects(expected, actual);
+
+			flatBVH.QueryAABB(boxQueries[i], actual);
+			result.isMatching = result.isMatching && SameObjects(expected, actual);
+
+			std::uint32_t expectedObject = 0;
+			std::uint32_t actualObject = 0;
+			float expectedDistance = 0.0f;
+			float actualDistance = 0.0f;
+			bool expectedHit = serialBVH.Raycast(rayQueries[i].origin, rayQueries[i].direction, rayLength, expectedObject, expectedDistance);
+			bool actualHit = flatBVH.Raycast(rayQueries[i].origin, rayQueries[i].direction, rayLength, actualObject, actualDistance);
+
+			result.isMatching = result.isMatching && SameRayHit(expectedHit, expectedDistance, actualHit, actualDistance, rayLength);
+		}
+
+		//   ڽ  Ա ŰǷ  Ȯ
+		const float infinity = std::numeric_limits<float>::infinity();
+		const BoundingBox everything{ XMFLOAT3{ 0.0f, 0.0f, 0.0f }, XMFLOAT3{ infinity, infinity, infinity } };
+
+		flatBVH.QueryAABB(everything, actual);
+		result.isMatching = result.isMatching && actual.size() == scene.boxes.size();
+
+		return result;
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			bool hasValue = i + 1 < argc;
+
+			if (std::strcmp(argv[i], "--sizes") == 0 && hasValue)
+			{
+				options.sizes.clear();
+
+				std::string list = argv[++i];
+				std::size_t begin = 0;
+				while (begin < list.size())
+				{
+					std::size_t end = list.find(',', begin);
+					if (end == std::string::npos)
+					{
+						end = list.size();
+					}
+
+					options.sizes.push_back(static_cast<std::uint32_t>(std::strtoul(list.substr(begin, end - begin).c_str(), nullptr, 10)));
+					begin = end + 1;
+				}
+			}
+			else if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+			{
+				options.frames = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+			}
+			else if (std::strcmp(argv[i], "--queries") == 0 && hasValue)
+			{
+				options.queries = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+			}
+			else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+			{
+				options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+			}
+			else
+			{
+				std::printf("usage: %s [--sizes 1000,10000,100000] [--frames 10] [--queries 10000] [--seed 1]\n", argv[0]);
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		return 2;
+	}
+
+	using SceneFactory = std::function<Scene(std::uint32_t, std::mt19937&)>;
+	const SceneFactory sceneFactories[] = { MakeUniformScene, MakeClusteredScene, MakeLongThinScene, MakeCrowdScene };
+
+	bool allValid = true;
+
+	std::printf("%-13s %8s  %-15s %10s %11s %9s %8s %6s %12s %12s  %s\n",
+		"scene", "objects", "strategy", "build(ms)", "update(ms)", "SAH cost", "nodes", "depth", "AABB q/s", "rays/s", "valid");
+
+	for (std::uint32_t size : options.sizes)
+	{
+		if (size == 0)
+		{
+			continue;
+		}
+
+		for (const auto& factory : sceneFactories)
+		{
+			std::mt19937 rng(options.seed);
+			Scene scene = factory(size, rng);
+
+			for (int s = 0; s < static_cast<int>(Strategy::Count); ++s)
+			{
+				Result result = RunStrategy(scene, static_cast<Strategy>(s), options);
+
+				std::printf("%-13s %8u  %-15s %10.2f %11.3f %9.2f %8u %6u %12.0f %12.0f  %s\n",
+					scene.name, size, STRATEGY_NAMES[s], result.buildMs, result.updateMs, result.sahCost,
+					result.nodeCount, result.depth, result.aabbQueriesPerSec, result.raysPerSec, result.isValid ? "ok" : "FAILED");
+
+				allValid = allValid && result.isValid;
+			}
+		}
+	}
+
+	std::printf("\n%-13s %8s %10s %10s %10s %12s %12s %12s %12s %12s %12s  %s\n",
+		"scene", "objects", "SAH(ms)", "par(ms)", "flat(ms)", "AABB q/s", "flat AABB", "sphere q/s", "flat sphere", "rays/s", "flat rays", "match");
+
+	for (std::uint32_t size : options.sizes)
+	{
+		if (size == 0)
+		{
+			continue;
+		}
+
+		for (const auto& factory : sceneFactories)
+		{
+			std::mt19937 rng(options.seed);
+			Scene scene = factory(size, rng);
+
+			FlatResult result = RunFlatComparison(scene, options);
+
+			std::printf("%-13s %8u %10.2f %10.2f %10.2f %12.0f %12.0f %12.0f %12.0f %12.0f %12.0f  %s\n",
+				scene.name, size, result.serialBuildMs, result.parallelBuildMs, result.flatBuildMs,
+				result.bvhAABBQueriesPerSec, result.flatAABBQueriesPerSec, result.bvhSphereQueriesPerSec, result.flatSphereQueriesPerSec,
+				result.bvhRaysPerSec, result.flatRaysPerSec, result.isMatching ? "ok" : "FAILED");
+
+			allValid = allValid && result.isMatching;
+		}
+	}
+
+	return allValid ? 0 : 1;
+}
@@ -0,0 +1,1000 @@
+#include "FlatBVH.h"
+
+#include "../Common/BVH.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using DirectX::XMVECTOR;
+using DirectX::FXMVECTOR;
+using BVH4::Lanes;
+using BVH4::LoadLanes;
+using BVH4::LaneMask;
+using BVH4::FirstLane;
+using BVH4::IsEmptyLane;
+
+namespace
+{
+	//   Ե   Ʈ ٿ ÿ ְ,  ˻  
+	constexpr std::uint32_t INSIDE_FLAG = 0x80000000u;
+
+	//   ּҴ  ̹Ƿ   ¸  (alignas(64)) ߸ 
+	constexpr std::uint64_t FILE_ALIGNMENT = alignof(FlatBVHNode);
+
+	//   . Ʒ º /Ʈ 迭 ޸  ״  
+	struct FileHeader
+	{
+		std::uint32_t magic;
+		std::uint32_t version;
+		// ü ũⰡ ٸ   ɷ
+		std::uint32_t nodeSize;
+		std::uint32_t objectSize;
+		std::uint32_t nodeCount;
+		std::uint32_t objectCount;
+		std::uint32_t maxDepth;
+		std::uint32_t reserved;
+		std::uint64_t nodeOffset;
+		std::uint64_t objectOffset;
+		std::uint64_t fileSize;
+	};
+
+	std::uint64_t AlignFileOffset(std::uint64_t offset)
+	{
+		return (offset + FILE_ALIGNMENT - 1) & ~(FILE_ALIGNMENT - 1);
+	}
+
+	bool IsValidHeader(const FileHeader* header, std::size_t size)
+	{
+		if (size < sizeof(FileHeader) ||
+			header->magic != FlatBVH::FILE_MAGIC ||
+			header->version != FlatBVH::FILE_VERSION ||
+			header->nodeSize != sizeof(FlatBVHNode) ||
+			header->objectSize != sizeof(FlatBVHObject) ||
+			header->fileSize != size)
+		{
+			return false;
+		}
+
+		if (header->nodeOffset % FILE_ALIGNMENT != 0 || header->objectOffset % alignof(FlatBVHObject) != 0)
+		{
+			return false;
+		}
+
+		//    Ȯؼ Ʒ  ġ ʰ .  + ̴ ū  ư  ־  
+		if (header->nodeOffset < sizeof(FileHeader) ||
+			header->nodeOffset > header->objectOffset ||
+			header->objectOffset > header->fileSize)
+		{
+			return false;
+		}
+
+		const std::uint64_t objectBytes = header->fileSize - header->objectOffset;
+		if (header->nodeCount > (header->objectOffset - header->nodeOffset) / sizeof(FlatBVHNode) ||
+			objectBytes % sizeof(FlatBVHObject) != 0 ||
+			header->objectCount != objectBytes / sizeof(FlatBVHObject))
+		{
+			return false;
+		}
+
+		//   ε INSIDE_FLAG ٿ ÿ Ƿ  Ʈ   
+		if (header->nodeCount >= INSIDE_FLAG)
+		{
+			return false;
+		}
+
+		//  Ʈ(0 ) ϹǷ 尡  ̵ ־ 
+		return (header->nodeCount == 0) == (header->maxDepth == 0);
+	}
+
+	// Build ڽ ׻ θ𺸴 ڿ Ƿ տ   鼭
+	//  ڽ ڱ⺸  带   Ű(ȯ̳  ),   Ʈ 迭  Ȯϰ ̸ 
+	bool ValidateNodes(const FlatBVHNode* nodes, std::uint32_t nodeCount, std::uint32_t objectCount, std::uint32_t& outMaxDepth)
+	{
+		outMaxDepth = 0;
+
+		if (nodeCount == 0)
+		{
+			return true;
+		}
+
+		// 0̸  ƹ Ű  
+		std::vector<std::uint32_t> depths(nodeCount, 0);
+		depths[0] = 1;
+
+		for (std::uint32_t i = 0; i < nodeCount; ++i)
+		{
+			if (depths[i] == 0)
+			{
+				return false;
+			}
+
+			outMaxDepth = std::max(outMaxDepth, depths[i]);
+
+			const FlatBVHNode& node = nodes[i];
+
+			for (std::uint32_t lane = 0; lane < FlatBVH::WIDTH; ++lane)
+			{
+				std::uint32_t child = node.child[lane];
+				std::uint32_t count = node.count[lane];
+
+				if (child == FlatBVH::EMPTY_LANE)
+				{
+					if (count != 0)
+					{
+						return false;
+					}
+				}
+				else if (count == 0)
+				{
+					if (child <= i || child >= nodeCount || depths[child] != 0)
+					{
+						return false;
+					}
+
+					depths[child] = depths[i] + 1;
+				}
+				else if (child > objectCount || count > objectCount - child)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	//  ü б  .   ִ  / ڵ ݾƵ 
+	bool MapFileReadOnly(const std::filesystem::path& path, const void*& outView, std::size_t& outSize)
+	{
+#ifdef _WIN32
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize{};
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+
+		if (mapping == nullptr)
+		{
+			return false;
+		}
+
+		const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+
+		if (view == nullptr)
+		{
+			return false;
+		}
+
+		outView = view;
+		outSize = static_cast<std::size_t>(fileSize.QuadPart);
+
+		return true;
+#else
+		int file = open(path.c_str(), O_RDONLY);
+		if (file == -1)
+		{
+			return false;
+		}
+
+		struct stat fileStat{};
+		if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			close(file);
+			return false;
+		}
+
+		void* view = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, file, 0);
+		close(file);
+
+		if (view == MAP_FAILED)
+		{
+			return false;
+		}
+
+		outView = view;
+		outSize = static_cast<std::size_t>(fileStat.st_size);
+
+		return true;
+#endif
+	}
+
+	void UnmapFile(const void* view, std::size_t size)
+	{
+#ifdef _WIN32
+		(void)size;
+		UnmapViewOfFile(view);
+#else
+		munmap(const_cast<void*>(view), size);
+#endif
+	}
+
+	//  Լ ȿ δ ȸ ̶  尡  Ʈ ص .
+	//  ̴  迭 ϰ ׺  Ʈ  
+	class TraversalStack
+	{
+	public:
+		static constexpr std::uint32_t INLINE_DEPTH = 64;
+
+	private:
+		//  ϳ   ִ WIDTH Ƿ  * (WIDTH - 1) + 1̸ 
+		std::uint32_t m_inlineEntries[INLINE_DEPTH * (FlatBVH::WIDTH - 1) + 1];
+		std::vector<std::uint32_t> m_heapEntries;
+		std::uint32_t* m_entries;
+
+	public:
+		explicit TraversalStack(std::uint32_t maxDepth)
+		{
+			if (maxDepth <= INLINE_DEPTH)
+			{
+				m_entries = m_inlineEntries;
+			}
+			else
+			{
+				m_heapEntries.resize(static_cast<std::size_t>(maxDepth) * (FlatBVH::WIDTH - 1) + 1);
+				m_entries = m_heapEntries.data();
+			}
+		}
+
+		TraversalStack(const TraversalStack&) = delete;
+		TraversalStack& operator=(const TraversalStack&) = delete;
+
+		std::uint32_t* Data()
+		{
+			return m_entries;
+		}
+	};
+
+	struct FrustumLanes
+	{
+		DirectX::XMFLOAT4 planes[6];
+		XMVECTOR x[6];
+		XMVECTOR y[6];
+		XMVECTOR z[6];
+		XMVECTOR w[6];
+		XMVECTOR absX[6];
+		XMVECTOR absY[6];
+		XMVECTOR absZ[6];
+	};
+
+	FrustumLanes MakeFrustumLanes(const DirectX::BoundingFrustum& frustum)
+	{
+		XMVECTOR planes[6];
+		frustum.GetPlanes(&planes[0], &planes[1], &planes[2], &planes[3], &planes[4], &planes[5]);
+
+		FrustumLanes result;
+		for (int i = 0; i < 6; ++i)
+		{
+			DirectX::XMStoreFloat4(&result.planes[i], planes[i]);
+			result.x[i] = DirectX::XMVectorSplatX(planes[i]);
+			result.y[i] = DirectX::XMVectorSplatY(planes[i]);
+			result.z[i] = DirectX::XMVectorSplatZ(planes[i]);
+			result.w[i] = DirectX::XMVectorSplatW(planes[i]);
+			result.absX[i] = DirectX::XMVectorAbs(result.x[i]);
+			result.absY[i] = DirectX::XMVectorAbs(result.y[i]);
+			result.absZ[i] = DirectX::XMVectorAbs(result.z[i]);
+		}
+
+		return result;
+	}
+
+	// 4 ڽ   ˻ؼ ϴ ԰  ԵǴ  ũ 
+	void TestFrustumLanes(const FrustumLanes& frustum, const Lanes& lanes, std::uint32_t& outVisible, std::uint32_t& outInside)
+	{
+		using namespace DirectX;
+
+		XMVECTOR half = XMVectorReplicate(0.5f);
+		XMVECTOR cx = XMVectorMultiply(XMVectorAdd(lanes.minX, lanes.maxX), half);
+		XMVECTOR cy = XMVectorMultiply(XMVectorAdd(lanes.minY, lanes.maxY), half);
+		XMVECTOR cz = XMVectorMultiply(XMVectorAdd(lanes.minZ, lanes.maxZ), half);
+		XMVECTOR ex = XMVectorMultiply(XMVectorSubtract(lanes.maxX, lanes.minX), half);
+		XMVECTOR ey = XMVectorMultiply(XMVectorSubtract(lanes.maxY, lanes.minY), half);
+		XMVECTOR ez = XMVectorMultiply(XMVectorSubtract(lanes.maxZ, lanes.minZ), half);
+
+		XMVECTOR outside = XMVectorFalseInt();
+		XMVECTOR intersect = XMVectorFalseInt();
+
+		for (int i = 0; i < 6; ++i)
+		{
+			XMVECTOR distance = XMVectorMultiplyAdd(frustum.x[i], cx,
+				XMVectorMultiplyAdd(frustum.y[i], cy,
+					XMVectorMultiplyAdd(frustum.z[i], cz, frustum.w[i])));
+
+			XMVECTOR radius = XMVectorMultiplyAdd(frustum.absX[i], ex,
+				XMVectorMultiplyAdd(frustum.absY[i], ey,
+					XMVectorMultiply(frustum.absZ[i], ez)));
+
+			outside = XMVectorOrInt(outside, XMVectorGreater(distance, radius));
+			intersect = XMVectorOrInt(intersect, XMVectorGreater(distance, XMVectorNegate(radius)));
+		}
+
+		outVisible = ~LaneMask(outside) & 0xF;
+		outInside = outVisible & ~LaneMask(intersect);
+	}
+
+	bool ObjectInFrustum(const FrustumLanes& frustum, const FlatBVHObject& object)
+	{
+		for (const auto& p : frustum.planes)
+		{
+			//       ٱ̸ Ż
+			float x = p.x > 0.0f ? object.min.x : object.max.x;
+			float y = p.y > 0.0f ? object.min.y : object.max.y;
+			float z = p.z > 0.0f ? object.min.z : object.max.z;
+
+			if (p.x * x + p.y * y + p.z * z + p.w > 0.0f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	std::uint32_t TestAABBLanes(const Lanes& lanes, FXMVECTOR queryMinX, FXMVECTOR queryMinY, FXMVECTOR queryMinZ,
+		DirectX::GXMVECTOR queryMaxX, DirectX::HXMVECTOR queryMaxY, DirectX::HXMVECTOR queryMaxZ)
+	{
+		using namespace DirectX;
+
+		XMVECTOR overlap = XMVectorAndInt(XMVectorLessOrEqual(lanes.minX, queryMaxX), XMVectorGreaterOrEqual(lanes.maxX, queryMinX));
+		overlap = XMVectorAndInt(overlap, XMVectorAndInt(XMVectorLessOrEqual(lanes.minY, queryMaxY), XMVectorGreaterOrEqual(lanes.maxY, queryMinY)));
+		overlap = XMVectorAndInt(overlap, XMVectorAndInt(XMVectorLessOrEqual(lanes.minZ, queryMaxZ), XMVectorGreaterOrEqual(lanes.maxZ, queryMinZ)));
+
+		return LaneMask(overlap);
+	}
+
+	bool ObjectOverlaps(const FlatBVHObject& object, const DirectX::XMFLOAT3& min, const DirectX::XMFLOAT3& max)
+	{
+		return object.min.x <= max.x && object.max.x >= min.x &&
+			object.min.y <= max.y && object.max.y >= min.y &&
+			object.min.z <= max.z && object.max.z >= min.z;
+	}
+
+	float DistanceSquared(const DirectX::XMFLOAT3& point, const DirectX::XMFLOAT3& min, const DirectX::XMFLOAT3& max)
+	{
+		float dx = std::max(std::max(min.x - point.x, point.x - max.x), 0.0f);
+		float dy = std::max(std::max(min.y - point.y, point.y - max.y), 0.0f);
+		float dz = std::max(std::max(min.z - point.z, point.z - max.z), 0.0f);
+
+		return dx * dx + dy * dy + dz * dz;
+	}
+}
+
+void FlatBVH::Build(const BVH& bvh, bool collapseToBVH4)
+{
+	Clear();
+
+	const auto& srcNodes = bvh.GetNodes();
+	const auto& srcObjectIndices = bvh.GetObjectIndices();
+	const auto& srcObjectAABBs = bvh.GetObjectAABBs();
+	const auto& srcObjectIDs = bvh.GetObjectIDs();
+
+	if (bvh.GetRootIndex() == BVH::INVALID_INDEX)
+	{
+		return;
+	}
+
+	m_nodes.reserve(srcNodes.size() / 2 + 1);
+	m_objects.reserve(srcObjectAABBs.size());
+
+	struct BuildItem
+	{
+		std::uint32_t srcIndex;
+		std::uint32_t flatIndex;
+		std::uint32_t depth;
+	};
+
+	std::vector<BuildItem> stack;
+	stack.push_back({ bvh.GetRootIndex(), 0, 1 });
+	m_nodes.emplace_back();
+
+	while (!stack.empty())
+	{
+		BuildItem item = stack.back();
+		stack.pop_back();
+
+		m_maxDepth = std::max(m_maxDepth, item.depth);
+
+		std::uint32_t lanes[WIDTH];
+		std::uint32_t laneCount = 0;
+
+		const auto& srcNode = srcNodes[item.srcIndex];
+
+		if (srcNode.IsLeaf())
+		{
+			// Ʈ ü  ϳ 
+			lanes[laneCount++] = item.srcIndex;
+		}
+		else
+		{
+			lanes[laneCount++] = srcNode.left;
+			lanes[laneCount++] = srcNode.right;
+
+			// ǥ  ū     ڽ ѷ ħ
+			while (collapseToBVH4 && laneCount < WIDTH)
+			{
+				int bestLane = -1;
+				float bestArea = -1.0f;
+
+				for (std::uint32_t i = 0; i < laneCount; ++i)
+				{
+					const auto& candidate = srcNodes[lanes[i]];
+					if (candidate.IsLeaf())
+					{
+						continue;
+					}
+
+					const auto& e = candidate.aabb.Extents;
+					float area = e.x * e.y + e.y * e.z + e.z * e.x;
+
+					if (area > bestArea)
+					{
+						bestArea = area;
+						bestLane = static_cast<int>(i);
+					}
+				}
+
+				if (bestLane == -1)
+				{
+					break;
+				}
+
+				const auto& opened = srcNodes[lanes[bestLane]];
+				lanes[bestLane] = opened.left;
+				lanes[laneCount++] = opened.right;
+			}
+		}
+
+		FlatBVHNode flatNode;
+
+		for (std::uint32_t lane = 0; lane < WIDTH; ++lane)
+		{
+			if (lane >= laneCount)
+			{
+				BVH4::ClearLane(flatNode, lane);
+				continue;
+			}
+
+			const auto& laneNode = srcNodes[lanes[lane]];
+			const auto& c = laneNode.aabb.Center;
+			const auto& e = laneNode.aabb.Extents;
+
+			flatNode.minX[lane] = c.x - e.x;
+			flatNode.minY[lane] = c.y - e.y;
+			flatNode.minZ[lane] = c.z - e.z;
+			flatNode.maxX[lane] = c.x + e.x;
+			flatNode.maxY[lane] = c.y + e.y;
+			flatNode.maxZ[lane] = c.z + e.z;
+
+			if (laneNode.IsLeaf())
+			{
+				flatNode.child[lane] = static_cast<std::uint32_t>(m_objects.size());
+				flatNode.count[lane] = laneNode.objectCount;
+
+				// BVH fat AABB   AABB  ũǷ    Ʈ AABB ٽ 
+				flatNode.minX[lane] = flatNode.minY[lane] = flatNode.minZ[lane] = FLT_MAX;
+				flatNode.maxX[lane] = flatNode.maxY[lane] = flatNode.maxZ[lane] = -FLT_MAX;
+
+				for (std::uint32_t i = 0; i < laneNode.objectCount; ++i)
+				{
+					std::uint32_t objIndex = srcObjectIndices[laneNode.firstObject + i];
+					const auto& bounds = srcObjectAABBs[objIndex];
+
+					FlatBVHObject object{};
+					object.min = { bounds.Center.x - bounds.Extents.x, bounds.Center.y - bounds.Extents.y, bounds.Center.z - bounds.Extents.z };
+					object.max = { bounds.Center.x + bounds.Extents.x, bounds.Center.y + bounds.Extents.y, bounds.Center.z + bounds.Extents.z };
+					object.id = srcObjectIDs[objIndex];
+
+					flatNode.minX[lane] = std::min(flatNode.minX[lane], object.min.x);
+					flatNode.minY[lane] = std::min(flatNode.minY[lane], object.min.y);
+					flatNode.minZ[lane] = std::min(flatNode.minZ[lane], object.min.z);
+					flatNode.maxX[lane] = std::max(flatNode.maxX[lane], object.max.x);
+					flatNode.maxY[lane] = std::max(flatNode.maxY[lane], object.max.y);
+					flatNode.maxZ[lane] = std::max(flatNode.maxZ[lane], object.max.z);
+
+					m_objects.push_back(object);
+				}
+			}
+			else
+			{
+				flatNode.child[lane] = static_cast<std::uint32_t>(m_nodes.size());
+				flatNode.count[lane] = 0;
+
+				m_nodes.emplace_back();
+				stack.push_back({ lanes[lane], flatNode.child[lane], item.depth + 1 });
+			}
+		}
+
+		m_nodes[item.flatIndex] = flatNode;
+	}
+
+	m_nodeData = m_nodes.data();
+	m_objectData = m_objects.data();
+	m_nodeCount = static_cast<std::uint32_t>(m_nodes.size());
+	m_objectCount = static_cast<std::uint32_t>(m_objects.size());
+}
+
+FlatBVH::~FlatBVH()
+{
+	Clear();
+}
+
+void FlatBVH::Clear()
+{
+	if (m_mappedView != nullptr)
+	{
+		UnmapFile(m_mappedView, m_mappedSize);
+
+		m_mappedView = nullptr;
+		m_mappedSize = 0;
+	}
+
+	m_nodes.clear();
+	m_objects.clear();
+	m_nodeData = nullptr;
+	m_objectData = nullptr;
+	m_nodeCount = 0;
+	m_objectCount = 0;
+	m_maxDepth = 0;
+}
+
+void FlatBVH::QueryFrustum(const DirectX::BoundingFrustum& frustum, std::vector<std::uint32_t>& outObjects) const
+{
+	outObjects.clear();
+
+	if (m_nodeCount == 0)
+	{
+		return;
+	}
+
+	FrustumLanes planes = MakeFrustumLanes(frustum);
+
+	TraversalStack traversalStack(m_maxDepth);
+	std::uint32_t* stack = traversalStack.Data();
+	std::uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize != 0)
+	{
+		std::uint32_t entry = stack[--stackSize];
+		const auto& node = m_nodeData[entry & ~INSIDE_FLAG];
+
+		std::uint32_t visible;
+		std::uint32_t inside;
+
+		if (entry & INSIDE_FLAG)
+		{
+			visible = 0xF;
+			inside = 0xF;
+		}
+		else
+		{
+			TestFrustumLanes(planes, LoadLanes(node), visible, inside);
+		}
+
+		for (std::uint32_t lane = 0; lane < WIDTH; ++lane)
+		{
+			if (!(visible & (1u << lane)) || IsEmptyLane(node, lane))
+			{
+				continue;
+			}
+
+			bool isInside = (inside & (1u << lane)) != 0;
+
+			if (node.count[lane] == 0)
+			{
+				stack[stackSize++] = node.child[lane] | (isInside ? INSIDE_FLAG : 0);
+			}
+			else if (isInside || node.count[lane] == 1)
+			{
+				AppendLeaf(node, lane, outObjects);
+			}
+			else
+			{
+				for (std::uint32_t i = 0; i < node.count[lane]; ++i)
+				{
+					const auto& object = m_objectData[node.child[lane] + i];
+
+					if (ObjectInFrustum(planes, object))
+					{
+						outObjects.push_back(object.id);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FlatBVH::QueryAABB(const DirectX::BoundingBox& aabb, std::vector<std::uint32_t>& outObjects) const
+{
+	using namespace DirectX;
+
+	outObjects.clear();
+
+	if (m_nodeCount == 0)
+	{
+		return;
+	}
+
+	XMFLOAT3 min{ aabb.Center.x - aabb.Extents.x, aabb.Center.y - aabb.Extents.y, aabb.Center.z - aabb.Extents.z };
+	XMFLOAT3 max{ aabb.Center.x + aabb.Extents.x, aabb.Center.y + aabb.Extents.y, aabb.Center.z + aabb.Extents.z };
+
+	XMVECTOR minX = XMVectorReplicate(min.x);
+	XMVECTOR minY = XMVectorReplicate(min.y);
+	XMVECTOR minZ = XMVectorReplicate(min.z);
+	XMVECTOR maxX = XMVectorReplicate(max.x);
+	XMVECTOR maxY = XMVectorReplicate(max.y);
+	XMVECTOR maxZ = XMVectorReplicate(max.z);
+
+	TraversalStack traversalStack(m_maxDepth);
+	std::uint32_t* stack = traversalStack.Data();
+	std::uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize != 0)
+	{
+		const auto& node = m_nodeData[stack[--stackSize]];
+
+		std::uint32_t overlap = TestAABBLanes(LoadLanes(node), minX, minY, minZ, maxX, maxY, maxZ);
+
+		while (overlap != 0)
+		{
+			int lane = FirstLane(overlap);
+			overlap &= overlap - 1;
+
+			//   min > max  ڽ FLT_MAX  񱳸 
+			if (IsEmptyLane(node, lane))
+			{
+				continue;
+			}
+
+			if (node.count[lane] == 0)
+			{
+				stack[stackSize++] = node.child[lane];
+			}
+			else if (node.count[lane] == 1)
+			{
+				AppendLeaf(node, lane, outObjects);
+			}
+			else
+			{
+				for (std::uint32_t i = 0; i < node.count[lane]; ++i)
+				{
+					const auto& object = m_objectData[node.child[lane] + i];
+
+					if (ObjectOverlaps(object, min, max))
+					{
+						outObjects.push_back(object.id);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FlatBVH::QuerySphere(const DirectX::BoundingSphere& sphere, std::vector<std::uint32_t>& outObjects) const
+{
+	using namespace DirectX;
+
+	outObjects.clear();
+
+	if (m_nodeCount == 0)
+	{
+		return;
+	}
+
+	XMVECTOR centerX = XMVectorReplicate(sphere.Center.x);
+	XMVECTOR centerY = XMVectorReplicate(sphere.Center.y);
+	XMVECTOR centerZ = XMVectorReplicate(sphere.Center.z);
+	XMVECTOR radiusSq = XMVectorReplicate(sphere.Radius * sphere.Radius);
+	XMVECTOR zero = XMVectorZero();
+
+	TraversalStack traversalStack(m_maxDepth);
+	std::uint32_t* stack = traversalStack.Data();
+	std::uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize != 0)
+	{
+		const auto& node = m_nodeData[stack[--stackSize]];
+		Lanes lanes = LoadLanes(node);
+
+		// ڽ  ߽ɱ ִ Ÿ 
+		XMVECTOR dx = XMVectorMax(XMVectorMax(XMVectorSubtract(lanes.minX, centerX), XMVectorSubtract(centerX, lanes.maxX)), zero);
+		XMVECTOR dy = XMVectorMax(XMVectorMax(XMVectorSubtract(lanes.minY, centerY), XMVectorSubtract(centerY, lanes.maxY)), zero);
+		XMVECTOR dz = XMVectorMax(XMVectorMax(XMVectorSubtract(lanes.minZ, centerZ), XMVectorSubtract(centerZ, lanes.maxZ)), zero);
+		XMVECTOR distanceSq = XMVectorMultiplyAdd(dx, dx, XMVectorMultiplyAdd(dy, dy, XMVectorMultiply(dz, dz)));
+
+		std::uint32_t overlap = LaneMask(XMVectorLessOrEqual(distanceSq, radiusSq));
+
+		while (overlap != 0)
+		{
+			int lane = FirstLane(overlap);
+			overlap &= overlap - 1;
+
+			if (IsEmptyLane(node, lane))
+			{
+				continue;
+			}
+
+			if (node.count[lane] == 0)
+			{
+				stack[stackSize++] = node.child[lane];
+			}
+			else if (node.count[lane] == 1)
+			{
+				AppendLeaf(node, lane, outObjects);
+			}
+			else
+			{
+				for (std::uint32_t i = 0; i < node.count[lane]; ++i)
+				{
+					const auto& object = m_objectData[node.child[lane] + i];
+
+					if (DistanceSquared(sphere.Center, object.min, object.max) <= sphere.Radius * sphere.Radius)
+					{
+						outObjects.push_back(object.id);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool FlatBVH::Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+	std::uint32_t& outObject, float& outDistance) const
+{
+	using namespace DirectX;
+
+	if (m_nodeCount == 0)
+	{
+		return false;
+	}
+
+	XMFLOAT3 invDirection{ 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+	XMVECTOR originX = XMVectorReplicate(origin.x);
+	XMVECTOR originY = XMVectorReplicate(origin.y);
+	XMVECTOR originZ = XMVectorReplicate(origin.z);
+	XMVECTOR invX = XMVectorReplicate(invDirection.x);
+	XMVECTOR invY = XMVectorReplicate(invDirection.y);
+	XMVECTOR invZ = XMVectorReplicate(invDirection.z);
+
+	//    max    
+	XMVECTOR negativeX = invDirection.x < 0.0f ? XMVectorTrueInt() : XMVectorFalseInt();
+	XMVECTOR negativeY = invDirection.y < 0.0f ? XMVectorTrueInt() : XMVectorFalseInt();
+	XMVECTOR negativeZ = invDirection.z < 0.0f ? XMVectorTrueInt() : XMVectorFalseInt();
+	XMVECTOR zero = XMVectorZero();
+
+	float closest = maxDistance;
+	bool hit = false;
+
+	TraversalStack traversalStack(m_maxDepth);
+	std::uint32_t* stack = traversalStack.Data();
+	std::uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize != 0)
+	{
+		const auto& node = m_nodeData[stack[--stackSize]];
+		Lanes lanes = LoadLanes(node);
+
+		XMVECTOR tNearX = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.minX, lanes.maxX, negativeX), originX), invX);
+		XMVECTOR tNearY = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.minY, lanes.maxY, negativeY), originY), invY);
+		XMVECTOR tNearZ = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.minZ, lanes.maxZ, negativeZ), originZ), invZ);
+		XMVECTOR tFarX = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.maxX, lanes.minX, negativeX), originX), invX);
+		XMVECTOR tFarY = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.maxY, lanes.minY, negativeY), originY), invY);
+		XMVECTOR tFarZ = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.maxZ, lanes.minZ, negativeZ), originZ), invZ);
+
+		XMVECTOR tNear = XMVectorMax(XMVectorMax(tNearX, tNearY), XMVectorMax(tNearZ, zero));
+		XMVECTOR tFar = XMVectorMin(XMVectorMin(tFarX, tFarY), XMVectorMin(tFarZ, XMVectorReplicate(closest)));
+
+		std::uint32_t hitMask = LaneMask(XMVectorLessOrEqual(tNear, tFar));
+		if (hitMask == 0)
+		{
+			continue;
+		}
+
+		XMFLOAT4A nearDistances;
+		XMStoreFloat4A(&nearDistances, tNear);
+		const float* laneDistances = &nearDistances.x;
+
+		//    ͺ ־  尡  
+		std::uint32_t pending[WIDTH];
+		float pendingDistances[WIDTH];
+		std::uint32_t pendingCount = 0;
+
+		for (std::uint32_t lane = 0; lane < WIDTH; ++lane)
+		{
+			if (!(hitMask & (1u << lane)) || IsEmptyLane(node, lane))
+			{
+				continue;
+			}
+
+			if (node.count[lane] == 0)
+			{
+				std::uint32_t insertAt = pendingCount++;
+				while (insertAt > 0 && pendingDistances[insertAt - 1] < laneDistances[lane])
+				{
+					pending[insertAt] = pending[insertAt - 1];
+					pendingDistances[insertAt] = pendingDistances[insertAt - 1];
+					--insertAt;
+				}
+
+				pending[insertAt] = node.child[lane];
+				pendingDistances[insertAt] = laneDistances[lane];
+
+				continue;
+			}
+
+			for (std::uint32_t i = 0; i < node.count[lane]; ++i)
+			{
+				const auto& object = m_objectData[node.child[lane] + i];
+
+				float tx1 = (object.min.x - origin.x) * invDirection.x;
+				float tx2 = (object.max.x - origin.x) * invDirection.x;
+				float ty1 = (object.min.y - origin.y) * invDirection.y;
+				float ty2 = (object.max.y - origin.y) * invDirection.y;
+				float tz1 = (object.min.z - origin.z) * invDirection.z;
+				float tz2 = (object.max.z - origin.z) * invDirection.z;
+
+				float tMin = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+				float tMax = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+
+				if (tMin <= tMax && tMin <= closest)
+				{
+					closest = tMin;
+					outObject = object.id;
+					hit = true;
+				}
+			}
+		}
+
+		for (std::uint32_t i = 0; i < pendingCount; ++i)
+		{
+			if (pendingDistances[i] <= closest)
+			{
+				stack[stackSize++] = pending[i];
+			}
+		}
+	}
+
+	if (hit)
+	{
+		outDistance = closest;
+	}
+
+	return hit;
+}
+
+bool FlatBVH::Save(const std::filesystem::path& path) const
+{
+	FileHeader header{};
+	header.magic = FILE_MAGIC;
+	header.version = FILE_VERSION;
+	header.nodeSize = sizeof(FlatBVHNode);
+	header.objectSize = sizeof(FlatBVHObject);
+	header.nodeCount = m_nodeCount;
+	header.objectCount = m_objectCount;
+	header.maxDepth = m_maxDepth;
+	header.nodeOffset = AlignFileOffset(sizeof(FileHeader));
+	header.objectOffset = AlignFileOffset(header.nodeOffset + static_cast<std::uint64_t>(m_nodeCount) * sizeof(FlatBVHNode));
+	header.fileSize = header.objectOffset + static_cast<std::uint64_t>(m_objectCount) * sizeof(FlatBVHObject);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		return false;
+	}
+
+	const char padding[FILE_ALIGNMENT] = {};
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(padding, static_cast<std::streamsize>(header.nodeOffset - sizeof(header)));
+	file.write(reinterpret_cast<const char*>(m_nodeData), static_cast<std::streamsize>(m_nodeCount) * sizeof(FlatBVHNode));
+	file.write(padding, static_cast<std::streamsize>(header.objectOffset - header.nodeOffset - static_cast<std::uint64_t>(m_nodeCount) * sizeof(FlatBVHNode)));
+	file.write(reinterpret_cast<const char*>(m_objectData), static_cast<std::streamsize>(m_objectCount) * sizeof(FlatBVHObject));
+
+	return static_cast<bool>(file);
+}
+
+bool FlatBVH::LoadMapped(const std::filesystem::path& path)
+{
+	Clear();
+
+	const void* view = nullptr;
+	std::size_t size = 0;
+
+	if (!MapFileReadOnly(path, view, size))
+	{
+		return false;
+	}
+
+	const auto* bytes = static_cast<const std::uint8_t*>(view);
+	const auto* header = static_cast<const FileHeader*>(view);
+
+	if (!IsValidHeader(header, size))
+	{
+		UnmapFile(view, size);
+		return false;
+	}
+
+	const auto* nodes = reinterpret_cast<const FlatBVHNode*>(bytes + header->nodeOffset);
+	std::uint32_t maxDepth = 0;
+
+	if (!ValidateNodes(nodes, header->nodeCount, header->objectCount, maxDepth))
+	{
+		UnmapFile(view, size);
+		return false;
+	}
+
+	m_mappedView = view;
+	m_mappedSize = size;
+
+	m_nodeData = nodes;
+	m_objectData = reinterpret_cast<const FlatBVHObject*>(bytes + header->objectOffset);
+	m_nodeCount = header->nodeCount;
+	m_objectCount = header->objectCount;
+	m_maxDepth = maxDepth;
+
+	return true;
+}
+
+bool FlatBVH::IsMapped() const
+{
+	return m_mappedView != nullptr;
+}
+
+const FlatBVHNode* FlatBVH::GetNodes() const
+{
+	return m_nodeData;
+}
+
+std::uint32_t FlatBVH::GetNodeCount() const
+{
+	return m_nodeCount;
+}
+
+const FlatBVHObject* FlatBVH::GetObjects() const
+{
+	return m_objectData;
+}
+
+std::uint32_t FlatBVH::GetObjectCount() const
+{
+	return m_objectCount;
+}
+
+std::uint32_t FlatBVH::GetMaxDepth() const
+{
+	return m_maxDepth;
+}
+
+void FlatBVH::AppendLeaf(const FlatBVHNode& node, int lane, std::vector<std::uint32_t>& outObjects) const
+{
+	for (std::uint32_t i = 0; i < node.count[lane]; ++i)
+	{
+		outObjects.push_back(m_objectData[node.child[lane] + i].id);
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <DirectXCollision.h>
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+
+#include "../Common/BVH4.h"
+
+class BVH;
+
+//   child count Ʈ 迭 
+using FlatBVHNode = BVH4Node;
+
+struct FlatBVHObject
+{
+	DirectX::XMFLOAT3 min;
+	std::uint32_t id;
+	DirectX::XMFLOAT3 max;
+	std::uint32_t pad;
+};
+
+// BVH    б . BVH ٲ ٽ Build ؾ 
+// Save   LoadMapped б  ؼ Ľ  ״   ( μ  )
+//   ¸ ٲ Ƿ  忡 ÿ ȣص 
+class FlatBVH
+{
+public:
+	static constexpr std::uint32_t WIDTH = BVH4::WIDTH;
+	static constexpr std::uint32_t EMPTY_LANE = BVH4::EMPTY_LANE;
+
+	//   4Ʈ "FBV4". /Ʈ  ٲ FILE_VERSION ø
+	static constexpr std::uint32_t FILE_MAGIC = 0x34564246;
+	static constexpr std::uint32_t FILE_VERSION = 1;
+
+private:
+	// Build 쿡 . LoadMapped  ְ  ޸𸮸 Ŵ
+	std::vector<FlatBVHNode> m_nodes;
+	std::vector<FlatBVHObject> m_objects;
+
+	//  ׻  ͷ 
+	const FlatBVHNode* m_nodeData = nullptr;
+	const FlatBVHObject* m_objectData = nullptr;
+	std::uint32_t m_nodeCount = 0;
+	std::uint32_t m_objectCount = 0;
+	std::uint32_t m_maxDepth = 0;
+
+	const void* m_mappedView = nullptr;
+	std::size_t m_mappedSize = 0;
+
+public:
+	FlatBVH() = default;
+	~FlatBVH();
+	// Ͱ ڱ ۳  ŰǷ  
+	FlatBVH(const FlatBVH&) = delete;
+	FlatBVH& operator=(const FlatBVH&) = delete;
+
+	// collapseToBVH4 false  2   Ʈ ״ 
+	void Build(const BVH& bvh, bool collapseToBVH4 = true);
+	void Clear();
+
+	//  +  迭 + Ʈ 迭 ޸  ״  ( /ü ġ   )
+	bool Save(const std::filesystem::path& path) const;
+	//   (ڽ ε,  )   ˻ϰ 迭  ޸𸮸 ״ .
+	// ̴    ʰ ˻ϸ鼭 ٽ . ϸ  · false
+	bool LoadMapped(const std::filesystem::path& path);
+	bool IsMapped() const;
+
+	void QueryFrustum(const DirectX::BoundingFrustum& frustum, std::vector<std::uint32_t>& outObjects) const;
+	void QueryAABB(const DirectX::BoundingBox& aabb, std::vector<std::uint32_t>& outObjects) const;
+	void QuerySphere(const DirectX::BoundingSphere& sphere, std::vector<std::uint32_t>& outObjects) const;
+	bool Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+		std::uint32_t& outObject, float& outDistance) const;
+
+	const FlatBVHNode* GetNodes() const;
+	std::uint32_t GetNodeCount() const;
+	const FlatBVHObject* GetObjects() const;
+	std::uint32_t GetObjectCount() const;
+	std::uint32_t GetMaxDepth() const;
+
+private:
+	void AppendLeaf(const FlatBVHNode& node, int lane, std::vector<std::uint32_t>& outObjects) const;
+};
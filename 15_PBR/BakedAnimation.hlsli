@@ -0,0 +1,35 @@
+#ifndef BAKED_ANIMATION_HLSLI__
+#define BAKED_ANIMATION_HLSLI__
+
+//  ϳ  ,  ϳ ؼ  (ġ    0 ~ 2)
+Texture2D<float4> g_bakedAnimation : register(t0);
+
+cbuffer BakedAnimation : register(b9)
+{
+    uint g_bakedFrameRow0;
+    uint g_bakedFrameRow1;
+    float g_bakedFrameLerp;
+    float __pad5;
+}
+
+float4 LoadBakedTexel(uint x)
+{
+    float4 texel0 = g_bakedAnimation.Load(int3(x, g_bakedFrameRow0, 0));
+    float4 texel1 = g_bakedAnimation.Load(int3(x, g_bakedFrameRow1, 0));
+    
+    return lerp(texel0, texel1, g_bakedFrameLerp);
+}
+
+//  ϱ    . UpdateSkeletonPose  skeletonPose[boneIndex] 
+float4x4 LoadBakedBonePose(uint boneIndex)
+{
+    float4x4 transposed = float4x4(
+        LoadBakedTexel(boneIndex * 3 + 0),
+        LoadBakedTexel(boneIndex * 3 + 1),
+        LoadBakedTexel(boneIndex * 3 + 2),
+        float4(0.0f, 0.0f, 0.0f, 1.0f));
+    
+    return transpose(transposed);
+}
+
+#endif
@@ -0,0 +1,298 @@
+// â/D3D  BakedAnimationData ˻ϴ ׽Ʈ
+//   ¥ ռ Ŭ  SamplePalette AnimationPose::Sample    ȷƮ ,
+// Ŭ  ǥ   ,    AABB   δ Ȯ. ϳ Ʋ 1 ȯ
+
+#include "../../Common/BakedAnimationData.h"
+#include "../../Common/AnimationData.h"
+#include "../../Common/AnimationPose.h"
+#include "../../Common/SkeletonData.h"
+#include "../../Common/SkeletalMeshData.h"
+
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using DirectX::SimpleMath::Matrix;
+using DirectX::SimpleMath::Vector3;
+
+namespace
+{
+	constexpr float FRAMES_PER_SECOND = 30.0f;
+	// Ű  ġ  İ    ƾ ϰ,
+	//  ̴    ʹϾ  ̸ŭ  (Ӵ 3 ȸ )
+	constexpr float KEY_FRAME_TOLERANCE = 1e-4f;
+	constexpr float MID_FRAME_TOLERANCE = 5e-3f;
+
+	bool s_isPassing = true;
+
+	void Check(bool condition, const char* what)
+	{
+		if (!condition)
+		{
+			std::printf("FAILED: %s\n", what);
+			s_isPassing = false;
+		}
+	}
+
+	aiNodeAnim* CreateChannel(const char* boneName, const aiVector3D& position,
+		const std::vector<std::pair<double, aiQuaternion>>& rotationKeys)
+	{
+		auto* channel = new aiNodeAnim();
+		channel->mNodeName = aiString(boneName);
+
+		channel->mNumPositionKeys = 1;
+		channel->mPositionKeys = new aiVectorKey[1]{ aiVectorKey(0.0, position) };
+
+		channel->mNumRotationKeys = static_cast<unsigned int>(rotationKeys.size());
+		channel->mRotationKeys = new aiQuatKey[rotationKeys.size()];
+		for (size_t i = 0; i < rotationKeys.size(); ++i)
+		{
+			channel->mRotationKeys[i] = aiQuatKey(rotationKeys[i].first, rotationKeys[i].second);
+		}
+
+		channel->mNumScalingKeys = 1;
+		channel->mScalingKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(1.0f, 1.0f, 1.0f)) };
+
+		return channel;
+	}
+
+	aiAnimation* CreateAnimation(const char* name, double durationTicks, std::vector<aiNodeAnim*> channels)
+	{
+		auto* animation = new aiAnimation();
+		animation->mName = aiString(name);
+		animation->mTicksPerSecond = FRAMES_PER_SECOND;
+		animation->mDuration = durationTicks;
+		animation->mNumChannels = static_cast<unsigned int>(channels.size());
+		animation->mChannels = new aiNodeAnim*[channels.size()];
+		std::copy(channels.begin(), channels.end(), animation->mChannels);
+
+		return animation;
+	}
+
+	// Scene Ʒ Root - Child. SkeletonData Ʈ  ù ڽĺ ̷ 
+	// 0 Ŭ: 1  Root Y 90, Child Z 90 
+	// 1 Ŭ: 0.5  Child X 45  (Root ε )
+	// 2 Ŭ: 10.5ƽ  Root Y 30 . ̰ 1 / fps  ƴ϶    
+	std::unique_ptr<aiScene> CreateTwoBoneScene()
+	{
+		auto scene = std::make_unique<aiScene>();
+		scene->mRootNode = new aiNode("Scene");
+
+		aiNode* root = new aiNode("Root");
+		aiNode* child = new aiNode("Child");
+		aiMatrix4x4::Translation(aiVector3D(0.0f, 1.0f, 0.0f), child->mTransformation);
+
+		root->addChildren(1, &child);
+		scene->mRootNode->addChildren(1, &root);
+
+		const aiVector3D yAxis(0.0f, 1.0f, 0.0f);
+		const aiVector3D zAxis(0.0f, 0.0f, 1.0f);
+		const aiVector3D xAxis(1.0f, 0.0f, 0.0f);
+
+		scene->mNumAnimations = 3;
+		scene->mAnimations = new aiAnimation*[3];
+		scene->mAnimations[0] = CreateAnimation("Swing", 30.0, {
+			CreateChannel("Root", aiVector3D(0.0f, 0.0f, 0.0f), {
+				{ 0.0, aiQuaternion(yAxis, 0.0f) },
+				{ 15.0, aiQuaternion(yAxis, DirectX::XM_PIDIV4) },
+				{ 30.0, aiQuaternion(yAxis, DirectX::XM_PIDIV2) } }),
+			CreateChannel("Child", aiVector3D(0.0f, 1.0f, 0.0f), {
+				{ 0.0, aiQuaternion(zAxis, 0.0f) },
+				{ 30.0, aiQuaternion(zAxis, DirectX::XM_PIDIV2) } }) });
+		scene->mAnimations[1] = CreateAnimation("Nod", 15.0, {
+			CreateChannel("Child", aiVector3D(0.0f, 1.0f, 0.0f), {
+				{ 0.0, aiQuaternion(xAxis, 0.0f) },
+				{ 15.0, aiQuaternion(xAxis, DirectX::XM_PIDIV4) } }) });
+		scene->mAnimations[2] = CreateAnimation("Turn", 10.5, {
+			CreateChannel("Root", aiVector3D(0.0f, 0.0f, 0.0f), {
+				{ 0.0, aiQuaternion(yAxis, 0.0f) },
+				{ 10.5, aiQuaternion(yAxis, DirectX::XM_PI / 6.0f) } }) });
+
+		return scene;
+	}
+
+	// SkeletalMesh::UpdateSkeletonPose   SimpleMath     (ġ )
+	std::vector<Matrix> CalculateReferenceModels(const std::vector<Bone>& skeleton, const PoseBuffer& pose)
+	{
+		std::vector<Matrix> models(skeleton.size());
+
+		for (const auto& bone : skeleton)
+		{
+			const Matrix local = Matrix::CreateScale(pose.scales[bone.index]) *
+				Matrix::CreateFromQuaternion(pose.rotations[bone.index]) *
+				Matrix::CreateTranslation(pose.translations[bone.index]);
+
+			models[bone.index] = bone.parentIndex == -1 ? local : local * models[bone.parentIndex];
+		}
+
+		return models;
+	}
+
+	float MaxDifference(const Matrix& a, const Matrix& b)
+	{
+		float result = 0.0f;
+		for (int row = 0; row < 4; ++row)
+		{
+			for (int column = 0; column < 4; ++column)
+			{
+				result = std::max(result, std::abs(a.m[row][column] - b.m[row][column]));
+			}
+		}
+
+		return result;
+	}
+
+	void CheckRowTable(const BakedAnimationData& baked)
+	{
+		const auto& clips = baked.GetClips();
+		Check(clips.size() == 3, "clip count");
+		if (clips.size() != 3)
+		{
+			return;
+		}
+
+		// duration * fps  + duration ġ  
+		Check(clips[0].firstFrame == 0 && clips[0].frameCount == 31, "clip 0 rows");
+		Check(clips[1].firstFrame == 31 && clips[1].frameCount == 16, "clip 1 rows");
+		Check(clips[2].firstFrame == 47 && clips[2].frameCount == 12, "clip 2 rows");
+		Check(baked.GetHeight() == 59, "texture height");
+		Check(baked.GetWidth() == 2 * BakedAnimationData::TEXELS_PER_BONE, "texture width");
+
+		// Ŭ ̳  ڴ   ϳ 
+		for (float time : { 1.0f, 5.0f })
+		{
+			const BakedAnimationFrame frame = baked.FindFrame(0, time);
+			Check(frame.row0 == 30 && frame.row1 == 30 && frame.lerp == 0.0f, "clip 0 last row clamp");
+		}
+
+		const BakedAnimationFrame lastFrame = baked.FindFrame(1, 0.5f);
+		Check(lastFrame.row0 == 46 && lastFrame.row1 == 46 && lastFrame.lerp == 0.0f, "clip 1 last row clamp");
+
+		const BakedAnimationFrame firstFrame = baked.FindFrame(1, -1.0f);
+		Check(firstFrame.row0 == 31 && firstFrame.row1 == 32 && firstFrame.lerp == 0.0f, "clip 1 first row clamp");
+
+		const BakedAnimationFrame midFrame = baked.FindFrame(0, 10.5f / FRAMES_PER_SECOND);
+		Check(midFrame.row0 == 10 && midFrame.row1 == 11 && std::abs(midFrame.lerp - 0.5f) < 1e-3f, "clip 0 mid frame rows");
+
+		//   duration(10.5) ġ     ʺ 
+		const BakedAnimationFrame shortFrame = baked.FindFrame(2, 10.25f / FRAMES_PER_SECOND);
+		Check(shortFrame.row0 == 57 && shortFrame.row1 == 58 && std::abs(shortFrame.lerp - 0.5f) < 1e-3f, "clip 2 last interval lerp");
+	}
+
+	//  ȷƮ  AABB time    . ȯ ȷƮ ִ 
+	float CompareAt(const BakedAnimationData& baked, const Animation& animation, size_t clipIndex, float time,
+		const std::vector<Bone>& skeleton, const PoseBuffer& bindPose, const SkeletalMeshSection& section, float tolerance)
+	{
+		PoseBuffer pose;
+		std::vector<LastKeyIndex> cursors;
+		AnimationPose::Sample(animation, time, bindPose, cursors, pose);
+		const std::vector<Matrix> models = CalculateReferenceModels(skeleton, pose);
+
+		const BakedAnimationFrame frame = baked.FindFrame(clipIndex, time);
+		BoneMatrixArray palette;
+		baked.SamplePalette(frame, palette);
+
+		float maxDifference = 0.0f;
+		for (const auto& bone : skeleton)
+		{
+			maxDifference = std::max(maxDifference, MaxDifference(palette[bone.index], models[bone.index].Transpose()));
+		}
+
+		//   ű  AABB    AABB ȿ ־ ø  
+		std::vector<DirectX::BoundingBox> sectionBounds;
+		baked.CalculateSectionBounds(frame, Matrix::Identity, sectionBounds);
+		Check(sectionBounds.size() == 1, "section bounds count");
+
+		if (!sectionBounds.empty())
+		{
+			DirectX::BoundingBox padded = sectionBounds[0];
+			padded.Extents.x += tolerance;
+			padded.Extents.y += tolerance;
+			padded.Extents.z += tolerance;
+
+			for (const auto& boneBounds : section.boneBounds)
+			{
+				Vector3 corners[DirectX::BoundingBox::CORNER_COUNT];
+				boneBounds.bounds.GetCorners(corners);
+
+				for (const auto& corner : corners)
+				{
+					const Vector3 point = Vector3::Transform(corner, models[boneBounds.boneIndex]);
+					Check(padded.Contains(point) == DirectX::CONTAINS, "section bounds contain posed bone bounds");
+				}
+			}
+		}
+
+		return maxDifference;
+	}
+}
+
+int main()
+{
+	const std::unique_ptr<aiScene> scene = CreateTwoBoneScene();
+
+	auto skeletonData = std::make_shared<SkeletonData>();
+	skeletonData->Create(scene.get());
+
+	AnimationData animationData;
+	animationData.Create(scene.get(), skeletonData);
+
+	//   ϳ ģ Ű  ϳ
+	SkeletalMeshSection section{};
+	section.boneBounds.push_back(BoneBounds{ 0, DirectX::BoundingBox(Vector3(0.0f, 0.5f, 0.0f), Vector3(0.2f, 0.5f, 0.2f)) });
+	section.boneBounds.push_back(BoneBounds{ 1, DirectX::BoundingBox(Vector3(0.0f, 0.5f, 0.0f), Vector3(0.1f, 0.5f, 0.1f)) });
+	const std::vector<SkeletalMeshSection> sections{ section };
+
+	BakedAnimationData baked;
+	baked.Create(*skeletonData, animationData, sections, FRAMES_PER_SECOND);
+
+	Check(baked.GetBoneCount() == 2, "bone count");
+	Check(baked.GetSectionCount() == 1, "section count");
+	CheckRowTable(baked);
+
+	std::vector<Bone> skeleton;
+	skeletonData->SetupSkeletonInstance(skeleton);
+	PoseBuffer bindPose;
+	AnimationPose::SetupBindPose(skeleton, bindPose);
+
+	const auto& animations = animationData.GetAnimations();
+	for (size_t clipIndex = 0; clipIndex < animations.size() && clipIndex < baked.GetClips().size(); ++clipIndex)
+	{
+		const Animation& animation = animations[clipIndex];
+		const BakedAnimationClip& clip = baked.GetClips()[clipIndex];
+
+		float keyFrameError = 0.0f;
+		float midFrameError = 0.0f;
+
+		for (std::uint32_t frame = 0; frame < clip.frameCount; ++frame)
+		{
+			const float keyTime = std::min(frame / FRAMES_PER_SECOND, clip.duration);
+			keyFrameError = std::max(keyFrameError,
+				CompareAt(baked, animation, clipIndex, keyTime, skeleton, bindPose, section, KEY_FRAME_TOLERANCE));
+
+			//    ð .   1 / fps ª  
+			if (frame + 1 < clip.frameCount)
+			{
+				const float nextKeyTime = std::min((frame + 1) / FRAMES_PER_SECOND, clip.duration);
+				const float midTime = (keyTime + nextKeyTime) * 0.5f;
+				midFrameError = std::max(midFrameError,
+					CompareAt(baked, animation, clipIndex, midTime, skeleton, bindPose, section, MID_FRAME_TOLERANCE));
+			}
+		}
+
+		std::printf("clip %zu: %u rows from %u, max palette error key %.6f mid %.6f\n",
+			clipIndex, clip.frameCount, clip.firstFrame, keyFrameError, midFrameError);
+
+		Check(keyFrameError <= KEY_FRAME_TOLERANCE, "palette at key frames");
+		Check(midFrameError <= MID_FRAME_TOLERANCE, "palette between key frames");
+	}
+
+	std::printf("%s\n", s_isPassing ? "ok" : "FAILED");
+
+	return s_isPassing ? 0 : 1;
+}
@@ -1,6 +1,7 @@
 #include "PBRApp.h"
 
 #include <cmath>
+#include <algorithm>
 #include <imgui.h>
 #include <imgui_impl_win32.h>
 #include <imgui_impl_dx11.h>
@@ -36,6 +37,9 @@ using Microsoft::WRL::ComPtr;
 
 #define USE_FLIPMODE
 
+// ĳ̵ near/far ߴ   (  ). Ŭ  ׸ ĳð    е 
+constexpr float ShadowDepthSnapRatio = 0.25f;
+
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 std::string FormatBytes(UINT64 bytes) {
@@ -136,38 +140,21 @@ void PBRApp::OnUpdate()
 	lightUp = DirectX::XMVector3TransformNormal(lightUp, m_lightRotationMatrix);
 	lightUp.Normalize();
 
+	// ġ ĳ̵帶   ʿ 
+	m_lightView = DirectX::XMMatrixLookToLH(Vector3::Zero, m_lightDirection, lightUp);
 
-	//m_lightFOV = std::min<float>(std::max<float>(m_camera.GetPosition().y / 100.0f, 1.0f), 5.0f);
-
-	if (m_lightFOV == 0.0f)
-	{
-		m_lightFOV = 0.01f;
-	}
-
-	if (m_lightNear == 0.0f)
-	{
-		m_lightNear = 1.0f;
-	}
-
-	if (m_lightFar == 0.0f || m_lightFar <= m_lightNear)
-	{
-		m_lightFar = 1000.0f;
-	}
-
-	Vector3 focusPosition = m_camera.GetPosition() + m_camera.GetForward() *
-		(m_camera.GetPosition().y < 1000.0f ? m_camera.GetPosition().y : (m_lightForwardDistFromCam + m_camera.GetPosition().y));
-	m_lightPosition = focusPosition + -m_lightDirection * m_lightFar * 0.92f;
-	m_lightView = DirectX::XMMatrixLookAtLH(m_lightPosition, focusPosition, lightUp);
+	UpdateAnimationLOD();
+	m_sharedAnimationPoseCount = SkeletalMesh::UpdateAll(m_skeletalMeshes, MyTime::DeltaTime(), m_useAnimationPoseCache);
 
-	m_lightProjection = DirectX::XMMatrixPerspectiveFovLH(
-		ToRadian(m_lightFOV),
-		static_cast<float>(m_shadowMapWidth) / m_shadowMapHeight,
-		m_lightNear,
-		m_lightFar);
+	// ޽ø ̸ SetTransform  ⼭  BVH Refit
+	m_sceneBVH.Update();
 
-	for (auto& mesh : m_skeletalMeshes)
+	// ȭ ߾ ŷ
+	m_pickedMeshIndex = -1;
+	if (m_sceneBVH.Raycast(m_camera.GetPosition(), m_camera.GetForward(), m_camera.GetFar(), m_pickHit))
 	{
-		mesh.Update(MyTime::DeltaTime());
+		auto find = std::find(m_staticMeshInstanceIDs.begin(), m_staticMeshInstanceIDs.end(), m_pickHit.instanceID);
+		m_pickedMeshIndex = static_cast<int>(find - m_staticMeshInstanceIDs.begin());
 	}
 }
 
@@ -182,6 +169,8 @@ void PBRApp::OnRender()
 		m_camera.GetNear(),
 		m_camera.GetFar());
 
+	CullScene();
+
 	// draw
 	auto deviceContext = m_graphicsDevice.GetDeviceContext();
 	auto renderTargetView = m_graphicsDevice.GetRenderTargetView();
@@ -198,8 +187,8 @@ void PBRApp::OnRender()
 	transformBuffer.view = m_view.Transpose();
 	transformBuffer.projection = m_projection.Transpose();
 	transformBuffer.lightView = m_lightView.Transpose();
-	transformBuffer.lightProjection = m_lightProjection.Transpose();
-	transformBuffer.lightViewProjection = (m_lightView * m_lightProjection).Transpose();
+	transformBuffer.lightProjection = m_cascades[0].projection.Transpose();
+	transformBuffer.lightViewProjection = (m_lightView * m_cascades[0].projection).Transpose();
 
 	deviceContext->UpdateSubresource(m_transformBuffer->GetRawBuffer(), 0, nullptr, &transformBuffer, 0, 0);
 
@@ -209,7 +198,7 @@ void PBRApp::OnRender()
 	environmentBuffer.lightIntensity = m_lightIntensity;
 	environmentBuffer.lightColor = m_lightColor;
 	environmentBuffer.ambientLightColor = m_ambientLightColor;
-	environmentBuffer.shadowMapSize = m_shadowMapWidth;// * m_shadowMapHeight;
+	environmentBuffer.shadowMapSize = m_shadowMapSize;
 	environmentBuffer.useShadowPCF = m_useShadowPCF;
 	if (m_useIBL)
 	{
@@ -224,23 +213,24 @@ void PBRApp::OnRender()
 
 	deviceContext->UpdateSubresource(m_overrideMatBuffer->GetRawBuffer(), 0, nullptr, &m_overrideMaterialCB, 0, 0);
 
+	CascadeConstant cascadeBuffer{};
+	for (int i = 0; i < m_cascadeCount; ++i)
+	{
+		cascadeBuffer.viewProjection[i] = (m_lightView * m_cascades[i].projection).Transpose();
+		cascadeBuffer.splitFar[i] = m_cascades[i].splitFar;
+	}
+	cascadeBuffer.cascadeCount = m_cascadeCount;
+
+	deviceContext->PSSetConstantBuffers(8, 1, m_cascadeConstantBuffer->GetBuffer().GetAddressOf());
+	deviceContext->UpdateSubresource(m_cascadeConstantBuffer->GetRawBuffer(), 0, nullptr, &cascadeBuffer, 0, 0);
+
+	// ׸ ĳ̵  н  ȷƮ Ƿ н    ø
+	SkeletalMesh::UploadSkinningPalettes(deviceContext, m_skeletalMeshes);
+
 	// common
 	deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	
 	// shadow
-	D3D11_VIEWPORT shadowViewport{};
-	shadowViewport.TopLeftX = 0;
-	shadowViewport.TopLeftY = 0;
-	shadowViewport.Width = static_cast<float>(m_shadowMapWidth);
-	shadowViewport.Height = static_cast<float>(m_shadowMapHeight);
-	shadowViewport.MinDepth = 0.0f;
-	shadowViewport.MaxDepth = 1.0f;
-
-	deviceContext->RSSetViewports(1, &shadowViewport);
-
-	deviceContext->OMSetRenderTargets(0, nullptr, m_shadowMapDSV->GetRawDepthStencilView());
-	deviceContext->ClearDepthStencilView(m_shadowMapDSV->GetRawDepthStencilView(), D3D11_CLEAR_DEPTH, 1.0f, 0);
-
 	RenderShadowMap();
 
 	// final
@@ -269,12 +259,13 @@ void PBRApp::OnRender()
 	deviceContext->IASetInputLayout(m_inputLayout.Get());
 	m_batch->Begin();
 
-	// Frustum   ġ
-	DirectX::BoundingFrustum frustum(m_lightProjection);
-	Matrix lightWorldMatrix = m_lightView.Invert();
-	frustum.Transform(frustum, lightWorldMatrix);
-
-	DX::Draw(m_batch.get(), frustum, DirectX::Colors::Blue);
+	// ĳ̵  ̹  
+	const DirectX::XMVECTORF32 cascadeColors[MaxShadowCascadeCount]{
+		DirectX::Colors::Red, DirectX::Colors::Lime, DirectX::Colors::Blue, DirectX::Colors::Yellow };
+	for (int i = 0; i < m_cascadeCount; ++i)
+	{
+		DX::Draw(m_batch.get(), m_cascades[i].volume, cascadeColors[i]);
+	}
 
 	m_batch->End();
 
@@ -293,40 +284,318 @@ void PBRApp::OnShutdown()
 	ShutdownImGui();
 }
 
+void PBRApp::CullScene()
+{
+	m_staticMeshCuller.Clear();
+	for (const auto& mesh : m_staticMeshes)
+	{
+		mesh.CalculateWorldBounds(m_sectionBounds);
+		m_staticMeshCuller.AddMesh(m_sectionBounds);
+	}
+
+	m_skeletalMeshCuller.Clear();
+	for (const auto& mesh : m_skeletalMeshes)
+	{
+		mesh.CalculateWorldBounds(m_sectionBounds);
+		m_skeletalMeshCuller.AddMesh(m_sectionBounds);
+	}
+
+	DirectX::BoundingFrustum cameraFrustum(m_projection);
+	cameraFrustum.Transform(cameraFrustum, m_view.Invert());
+
+	m_staticMeshCuller.Cull(cameraFrustum, m_cameraVisibleStaticMeshes);
+	m_skeletalMeshCuller.Cull(cameraFrustum, m_cameraVisibleSkeletalMeshes);
+
+	// ĳ    ̹  ޽ AABB ʿ
+	UpdateShadowCascades();
+
+	// ĳ̵帶 ڱ   ģ ĳ͸ ׸
+	for (int i = 0; i < m_cascadeCount; ++i)
+	{
+		auto& cascade = m_cascades[i];
+		m_staticMeshCuller.Cull(cascade.volume, cascade.visibleStaticMeshes);
+		m_skeletalMeshCuller.Cull(cascade.volume, cascade.visibleSkeletalMeshes);
+	}
+}
+
+void PBRApp::UpdateAnimationLOD()
+{
+	std::fill(std::begin(m_animationLODCounts), std::end(m_animationLODCounts), 0);
+
+	// ù ó ø    Full
+	const bool hasCullResult = m_skeletalMeshCuller.GetMeshCount() == m_skeletalMeshes.size();
+
+	m_skeletalMeshVisibility.assign(m_skeletalMeshes.size(), 0);
+	if (hasCullResult)
+	{
+		for (const auto& visibleMesh : m_cameraVisibleSkeletalMeshes.meshes)
+		{
+			m_skeletalMeshVisibility[visibleMesh.meshIndex] = 1;
+		}
+		for (int i = 0; i < m_cascadeCount; ++i)
+		{
+			for (const auto& visibleMesh : m_cascades[i].visibleSkeletalMeshes.meshes)
+			{
+				m_skeletalMeshVisibility[visibleMesh.meshIndex] = 1;
+			}
+		}
+	}
+
+	const Vector3 cameraPosition = m_camera.GetPosition();
+	const float tanHalfFov = std::tan(ToRadian(m_camera.GetFOV()) * 0.5f);
+
+	for (size_t i = 0; i < m_skeletalMeshes.size(); ++i)
+	{
+		AnimationLOD lod = AnimationLOD::Full;
+
+		if (m_useAnimationLOD && hasCullResult)
+		{
+			if (m_skeletalMeshVisibility[i] == 0)
+			{
+				lod = AnimationLOD::Frozen;
+			}
+			else
+			{
+				DirectX::BoundingSphere sphere;
+				DirectX::BoundingSphere::CreateFromBoundingBox(sphere, m_skeletalMeshCuller.GetMeshBounds(static_cast<std::uint32_t>(i)));
+
+				const float distance = Vector3::Distance(cameraPosition, sphere.Center);
+				//  ȿ ī޶  ȭ    
+				const float screenSize = distance > sphere.Radius ? sphere.Radius / (distance * tanHalfFov) : 1.0f;
+
+				if (screenSize >= m_animationLODScreenSizes[0])
+				{
+					lod = AnimationLOD::Full;
+				}
+				else if (screenSize >= m_animationLODScreenSizes[1])
+				{
+					lod = AnimationLOD::Half;
+				}
+				else
+				{
+					lod = AnimationLOD::Quarter;
+				}
+			}
+		}
+
+		m_skeletalMeshes[i].SetAnimationLOD(lod);
+		++m_animationLODCounts[static_cast<int>(lod)];
+	}
+}
+
+void PBRApp::UpdateShadowCascades()
+{
+	const float cameraNear = m_camera.GetNear();
+	const float shadowFar = std::max<float>(std::min<float>(m_shadowDistance, m_camera.GetFar()), cameraNear + 1.0f);
+	const float aspectRatio = static_cast<float>(m_width) / m_height;
+	const Matrix cameraWorld = m_view.Invert();
+
+	// culler ϵ ޽ ü AABB Ʈ  ּ . ޽ð  FLT_MAX
+	auto calculateMinLightSpaceZ = [this](const VisibilityCuller& culler)
+	{
+		if (culler.GetMeshCount() == 0)
+		{
+			return FLT_MAX;
+		}
+
+		DirectX::BoundingBox bounds = culler.GetMeshBounds(0);
+		for (std::uint32_t i = 1; i < culler.GetMeshCount(); ++i)
+		{
+			DirectX::BoundingBox::CreateMerged(bounds, bounds, culler.GetMeshBounds(i));
+		}
+
+		float minZ = FLT_MAX;
+		Vector3 corners[DirectX::BoundingBox::CORNER_COUNT];
+		bounds.GetCorners(corners);
+		for (const auto& corner : corners)
+		{
+			minZ = std::min<float>(minZ, Vector3::Transform(corner, m_lightView).z);
+		}
+
+		return minZ;
+	};
+
+	// near  ĳͷθ . ̴ ̷Ż ĳͱ    near ٲ  ĳð 
+	const float staticMinZ = calculateMinLightSpaceZ(m_staticMeshCuller);
+	const float skeletalMinZ = calculateMinLightSpaceZ(m_skeletalMeshCuller);
+
+	float splitNear = cameraNear;
+	for (int i = 0; i < m_cascadeCount; ++i)
+	{
+		auto& cascade = m_cascades[i];
+
+		// α Ұ յ    (practical split scheme)
+		const float ratio = static_cast<float>(i + 1) / m_cascadeCount;
+		const float logSplit = cameraNear * std::pow(shadowFar / cameraNear, ratio);
+		const float uniformSplit = cameraNear + (shadowFar - cameraNear) * ratio;
+		cascade.splitFar = m_cascadeSplitLambda * logSplit + (1.0f - m_cascadeSplitLambda) * uniformSplit;
+
+		DirectX::BoundingFrustum slice(DirectX::XMMatrixPerspectiveFovLH(
+			ToRadian(m_camera.GetFOV()), aspectRatio, splitNear, cascade.splitFar));
+		slice.Transform(slice, cameraWorld);
+
+		Vector3 corners[DirectX::BoundingFrustum::CORNER_COUNT];
+		slice.GetCorners(corners);
+
+		//  μ ī޶ Ƶ  ũⰡ  ʰ 
+		Vector3 center;
+		for (const auto& corner : corners)
+		{
+			center += corner;
+		}
+		center /= static_cast<float>(DirectX::BoundingFrustum::CORNER_COUNT);
+
+		float radius = 0.0f;
+		for (const auto& corner : corners)
+		{
+			radius = std::max<float>(radius, Vector3::Distance(center, corner));
+		}
+		radius = std::ceil(radius * 16.0f) / 16.0f;
+
+		// ߽ ؼ  缭 ī޶   ׸ ڸ  ʰ 
+		const float texelSize = radius * 2.0f / m_shadowMapSize;
+		Vector3 lightSpaceCenter = Vector3::Transform(center, m_lightView);
+		lightSpaceCenter.x = std::floor(lightSpaceCenter.x / texelSize) * texelSize;
+		lightSpaceCenter.y = std::floor(lightSpaceCenter.y / texelSize) * texelSize;
+
+		//  ۿ ׸ڸ 帮 ĳ͵ 㵵 near   ʺ  ĭ  .
+		// near/far   ģ ڿ 缭 ī޶  ̰ų ĳͰ ƴٳ൵  ״ 
+		const float depthStep = radius * ShadowDepthSnapRatio;
+		float nearZ = (std::floor(std::min<float>(lightSpaceCenter.z - radius, staticMinZ) / depthStep) - 1.0f) * depthStep;
+		const float farZ = std::ceil((lightSpaceCenter.z + radius) / depthStep) * depthStep;
+
+		// ̷Ż ĳͰ   ĭ    near  (̶  ĳø ٽ ׸)
+		if (skeletalMinZ < nearZ)
+		{
+			nearZ = (std::floor(skeletalMinZ / depthStep) - 1.0f) * depthStep;
+		}
+
+		cascade.projection = DirectX::XMMatrixOrthographicOffCenterLH(
+			lightSpaceCenter.x - radius, lightSpaceCenter.x + radius,
+			lightSpaceCenter.y - radius, lightSpaceCenter.y + radius,
+			nearZ, farZ);
+
+		const DirectX::BoundingOrientedBox lightSpaceVolume(
+			Vector3(lightSpaceCenter.x, lightSpaceCenter.y, (nearZ + farZ) * 0.5f),
+			Vector3(radius, radius, (farZ - nearZ) * 0.5f),
+			Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+		lightSpaceVolume.Transform(cascade.volume, m_lightView.Invert());
+
+		splitNear = cascade.splitFar;
+	}
+}
+
 void PBRApp::RenderShadowMap()
 {
 	const auto& deviceContext = m_graphicsDevice.GetDeviceContext();
 
+	D3D11_VIEWPORT shadowViewport{};
+	shadowViewport.TopLeftX = 0;
+	shadowViewport.TopLeftY = 0;
+	shadowViewport.Width = static_cast<float>(m_shadowMapSize);
+	shadowViewport.Height = static_cast<float>(m_shadowMapSize);
+	shadowViewport.MinDepth = 0.0f;
+	shadowViewport.MaxDepth = 1.0f;
+
+	deviceContext->RSSetViewports(1, &shadowViewport);
 	deviceContext->OMSetDepthStencilState(m_shadowMapDSS->GetRawDepthStencilState(), 0);
 	deviceContext->RSSetState(m_shadowMapRSS->GetRawRasterizerState());
 
-	for (auto& mesh : m_staticMeshes)
-	{
-		mesh.DrawShadowMap(deviceContext);
-	}
+	TransformBuffer transformBuffer{};
+	transformBuffer.view = m_view.Transpose();
+	transformBuffer.projection = m_projection.Transpose();
+	transformBuffer.lightView = m_lightView.Transpose();
 
-	for (auto& mesh : m_skeletalMeshes)
+	m_staticShadowRedrawCount = 0;
+
+	for (int i = 0; i < m_cascadeCount; ++i)
 	{
-		mesh.DrawShadowMap(deviceContext);
+		auto& cascade = m_cascades[i];
+
+		const Matrix viewProjection = m_lightView * cascade.projection;
+
+		transformBuffer.lightProjection = cascade.projection.Transpose();
+		transformBuffer.lightViewProjection = viewProjection.Transpose();
+		deviceContext->UpdateSubresource(m_transformBuffer->GetRawBuffer(), 0, nullptr, &transformBuffer, 0, 0);
+
+		if (m_useStaticShadowCache)
+		{
+			// xy ؼ  z   п ī޶  ؼ ̻ ̰ų Ʈ ų ĳͰ      ٲ
+			if (!cascade.isStaticCacheValid || cascade.cachedViewProjection != viewProjection)
+			{
+				deviceContext->OMSetRenderTargets(0, nullptr, cascade.staticDSV->GetRawDepthStencilView());
+				deviceContext->ClearDepthStencilView(cascade.staticDSV->GetRawDepthStencilView(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+
+				DrawStaticShadowCasters(cascade.visibleStaticMeshes);
+
+				cascade.cachedViewProjection = viewProjection;
+				cascade.isStaticCacheValid = true;
+				++m_staticShadowRedrawCount;
+			}
+
+			deviceContext->OMSetRenderTargets(0, nullptr, nullptr);
+
+			const UINT subresource = D3D11CalcSubresource(0, static_cast<UINT>(i), 1);
+			deviceContext->CopySubresourceRegion(m_shadowMapTex2D->GetRawTexture2D(), subresource, 0, 0, 0,
+				m_staticShadowMapTex2D->GetRawTexture2D(), subresource, nullptr);
+
+			deviceContext->OMSetRenderTargets(0, nullptr, cascade.dsv->GetRawDepthStencilView());
+		}
+		else
+		{
+			deviceContext->OMSetRenderTargets(0, nullptr, cascade.dsv->GetRawDepthStencilView());
+			deviceContext->ClearDepthStencilView(cascade.dsv->GetRawDepthStencilView(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+
+			DrawStaticShadowCasters(cascade.visibleStaticMeshes);
+			++m_staticShadowRedrawCount;
+		}
+
+		//  ĳʹ      ׸
+		for (const auto& visibleMesh : cascade.visibleSkeletalMeshes.meshes)
+		{
+			m_skeletalMeshes[visibleMesh.meshIndex].DrawShadowMap(deviceContext,
+				&cascade.visibleSkeletalMeshes.sectionIndices[visibleMesh.firstSection], visibleMesh.sectionCount);
+		}
 	}
 
 	deviceContext->RSSetState(nullptr);
 	deviceContext->OMSetDepthStencilState(nullptr, 0);
 }
 
+void PBRApp::DrawStaticShadowCasters(const VisibleList& visibleMeshes)
+{
+	const auto& deviceContext = m_graphicsDevice.GetDeviceContext();
+
+	for (const auto& visibleMesh : visibleMeshes.meshes)
+	{
+		m_staticMeshes[visibleMesh.meshIndex].DrawShadowMap(deviceContext,
+			&visibleMeshes.sectionIndices[visibleMesh.firstSection], visibleMesh.sectionCount);
+	}
+}
+
+void PBRApp::InvalidateStaticShadowCache()
+{
+	for (auto& cascade : m_cascades)
+	{
+		cascade.isStaticCacheValid = false;
+	}
+}
+
 void PBRApp::RenderGeometryPass()
 {
 	const auto& deviceContext = m_graphicsDevice.GetDeviceContext();
 
 	// mesh
-	for (auto& mesh : m_staticMeshes)
+	for (const auto& visibleMesh : m_cameraVisibleStaticMeshes.meshes)
 	{
-		mesh.Draw(deviceContext);
+		m_staticMeshes[visibleMesh.meshIndex].Draw(deviceContext,
+			&m_cameraVisibleStaticMeshes.sectionIndices[visibleMesh.firstSection], visibleMesh.sectionCount);
 	}
 
-	for (auto& mesh : m_skeletalMeshes)
+	for (const auto& visibleMesh : m_cameraVisibleSkeletalMeshes.meshes)
 	{
-		mesh.Draw(deviceContext);
+		m_skeletalMeshes[visibleMesh.meshIndex].Draw(deviceContext,
+			&m_cameraVisibleSkeletalMeshes.sectionIndices[visibleMesh.firstSection], visibleMesh.sectionCount);
 	}
 
 	ID3D11ShaderResourceView* nullSRV[]{ nullptr };
@@ -454,6 +723,38 @@ void PBRApp::RenderImGui()
 	ImGui::NewLine();
 
 	ImGui::SeparatorText("Object");
+	size_t lightVisibleSectionCount = 0;
+	for (int i = 0; i < m_cascadeCount; ++i)
+	{
+		lightVisibleSectionCount += m_cascades[i].visibleStaticMeshes.sectionIndices.size() +
+			m_cascades[i].visibleSkeletalMeshes.sectionIndices.size();
+	}
+	ImGui::Text("Visible Sections: Camera %zu, Light %zu / %u",
+		m_cameraVisibleStaticMeshes.sectionIndices.size() + m_cameraVisibleSkeletalMeshes.sectionIndices.size(),
+		lightVisibleSectionCount,
+		m_staticMeshCuller.GetSectionCount() + m_skeletalMeshCuller.GetSectionCount());
+	if (m_pickedMeshIndex != -1)
+	{
+		ImGui::Text("Picked: Mesh %d, Section %u, Triangle %u (%.1f)", m_pickedMeshIndex,
+			m_pickHit.meshHit.sectionIndex, m_pickHit.meshHit.triangleIndex, m_pickHit.meshHit.distance);
+	}
+	else
+	{
+		ImGui::Text("Picked: None");
+	}
+	ImGui::Checkbox("Animation LOD", &m_useAnimationLOD);
+	ImGui::SliderFloat2("Anim LOD Screen Size", m_animationLODScreenSizes, 0.0f, 1.0f);
+	ImGui::Text("Anim LOD: Full %d, Half %d, Quarter %d, Frozen %d",
+		m_animationLODCounts[0], m_animationLODCounts[1], m_animationLODCounts[2], m_animationLODCounts[3]);
+	ImGui::Checkbox("Share Animation Poses", &m_useAnimationPoseCache);
+	ImGui::Text("Shared Poses: %u / %zu", m_sharedAnimationPoseCount, m_skeletalMeshes.size());
+	if (ImGui::Checkbox("Baked Animation", &m_useBakedAnimation))
+	{
+		for (auto& mesh : m_skeletalMeshes)
+		{
+			mesh.SetUseBakedAnimation(m_useBakedAnimation);
+		}
+	}
 	if (ImGui::Checkbox("Override Material", &m_overrideMaterial))
 	{
 		if (m_overrideMaterial)
@@ -479,10 +780,13 @@ void PBRApp::RenderImGui()
 	ImGui::InputFloat3("Direction", &m_lightDirection.x, "%.3f", ImGuiInputTextFlags_ReadOnly);
 	ImGui::ColorEdit3("Direct", &m_lightColor.x);
 	ImGui::DragFloat("LightIntensity", &m_lightIntensity, 0.05f, 0.0f, 100.0f);
-	ImGui::DragFloat("LightNear", &m_lightNear);
-	ImGui::DragFloat("LightFar", &m_lightFar);
-	ImGui::DragFloat("LightFOV", &m_lightFOV, 0.0001f);
-	ImGui::DragFloat("ForwardFromCam", &m_lightForwardDistFromCam, 0.1f);
+	ImGui::SliderInt("Cascades", &m_cascadeCount, 2, MaxShadowCascadeCount);
+	ImGui::DragFloat("Shadow Distance", &m_shadowDistance, 10.0f, 100.0f, 100000.0f);
+	ImGui::SliderFloat("Split Lambda", &m_cascadeSplitLambda, 0.0f, 1.0f);
+	for (int i = 0; i < m_cascadeCount; ++i)
+	{
+		ImGui::Text("Cascade %d: ~%.1f", i, m_cascades[i].splitFar);
+	}
 	
 	if (ImGui::Button("Reset##3"))
 	{
@@ -521,7 +825,14 @@ void PBRApp::RenderImGui()
 	//}
 	ImGui::SliderFloat("Exposure", &m_hdrCB.exposure, -5.0f, 5.0f);
 	ImGui::Checkbox("Use Shadow PCF", &m_useShadowPCF);
-	ImGui::Image((ImTextureID)(intptr_t)m_shadowMapSRV->GetRawShaderResourceView(), ImVec2(300.0f, 300.0f));
+	if (ImGui::Checkbox("Cache Static Shadows", &m_useStaticShadowCache))
+	{
+		InvalidateStaticShadowCache();
+	}
+	ImGui::Text("Static Shadow Redraws: %d / %d", m_staticShadowRedrawCount, m_cascadeCount);
+	m_shadowMapPreviewIndex = std::min<int>(m_shadowMapPreviewIndex, m_cascadeCount - 1);
+	ImGui::SliderInt("Shadow Map", &m_shadowMapPreviewIndex, 0, m_cascadeCount - 1);
+	ImGui::Image((ImTextureID)(intptr_t)m_cascades[m_shadowMapPreviewIndex].srv->GetRawShaderResourceView(), ImVec2(300.0f, 300.0f));
 
 	ImGui::Text("%d FPS", GetLastFPS());
 
@@ -612,6 +923,7 @@ void PBRApp::InitializeScene()
 	m_overrideMatBuffer = D3DResourceManager::Get().GetOrCreateConstantBuffer(L"OverrideMat", sizeof(OverrideMaterial));
 	m_worldTransformBuffer = D3DResourceManager::Get().GetOrCreateConstantBuffer(L"WorldTransform", sizeof(WorldTransformBuffer));
 	m_hdrConstantBuffer = D3DResourceManager::Get().GetOrCreateConstantBuffer(L"HDRConstant", sizeof(HDRConstant));
+	m_cascadeConstantBuffer = D3DResourceManager::Get().GetOrCreateConstantBuffer(L"CascadeConstant", sizeof(CascadeConstant));
 
 	m_staticMeshes.emplace_back(L"char.fbx", L"GBufferPS.hlsl");
 	m_staticMeshes.back().SetWorld(DirectX::SimpleMath::Matrix::CreateTranslation(0.0f, 30.0f, 0.0f).Transpose());
@@ -627,6 +939,14 @@ void PBRApp::InitializeScene()
 
 	m_staticMeshes.emplace_back(L"Floor.fbx", L"GBufferPS.hlsl");
 
+	m_staticMeshInstanceIDs.reserve(m_staticMeshes.size());
+	for (const auto& mesh : m_staticMeshes)
+	{
+		m_staticMeshInstanceIDs.push_back(m_sceneBVH.AddInstance(mesh.GetStaticMeshData(), mesh.GetWorld().Transpose()));
+	}
+	m_sceneBVH.Rebuild();
+	InvalidateStaticShadowCache();
+
 	m_directLightingPS = D3DResourceManager::Get().GetOrCreatePixelShader(L"PBRPS.hlsl");
 	{
 		D3D11_SAMPLER_DESC samplerDesc{};
@@ -646,10 +966,10 @@ void PBRApp::InitializeScene()
 	// shadow mapping
 	{
 		D3D11_TEXTURE2D_DESC texDesc{};
-		texDesc.Width = static_cast<UINT>(m_shadowMapWidth);
-		texDesc.Height = static_cast<UINT>(m_shadowMapWidth);
+		texDesc.Width = static_cast<UINT>(m_shadowMapSize);
+		texDesc.Height = static_cast<UINT>(m_shadowMapSize);
 		texDesc.MipLevels = 1;
-		texDesc.ArraySize = 1;
+		texDesc.ArraySize = MaxShadowCascadeCount;
 		texDesc.Usage = D3D11_USAGE_DEFAULT;
 		texDesc.Format = DXGI_FORMAT_R32_TYPELESS;
 		texDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE;
@@ -658,19 +978,43 @@ void PBRApp::InitializeScene()
 
 		m_shadowMapTex2D = D3DResourceManager::Get().GetOrCreateTexture2D(L"ShadowMap", texDesc);
 
-		D3D11_DEPTH_STENCIL_VIEW_DESC dsvDesc{};
-		dsvDesc.Format = DXGI_FORMAT_D32_FLOAT;
-		dsvDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+		//  θ Ƿ SRV ʿ 
+		D3D11_TEXTURE2D_DESC staticTexDesc = texDesc;
+		staticTexDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
 
-		m_shadowMapDSV = D3DResourceManager::Get().GetOrCreateDepthStencilView(L"ShadowMap", m_shadowMapTex2D->GetTexture2D(), dsvDesc);
+		m_staticShadowMapTex2D = D3DResourceManager::Get().GetOrCreateTexture2D(L"StaticShadowMap", staticTexDesc);
 
 		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
 		srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
-		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Texture2D.MipLevels = 1;
+		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+		srvDesc.Texture2DArray.MipLevels = 1;
+		srvDesc.Texture2DArray.FirstArraySlice = 0;
+		srvDesc.Texture2DArray.ArraySize = MaxShadowCascadeCount;
 
 		m_shadowMapSRV = D3DResourceManager::Get().GetOrCreateShaderResourceView(L"ShadowMap", m_shadowMapTex2D->GetTexture2D(), srvDesc);
 
+		// ̽ DSV ϳ. SRV ImGui ̸
+		for (int i = 0; i < MaxShadowCascadeCount; ++i)
+		{
+			const std::wstring name = L"ShadowMapCascade" + std::to_wstring(i);
+
+			D3D11_DEPTH_STENCIL_VIEW_DESC dsvDesc{};
+			dsvDesc.Format = DXGI_FORMAT_D32_FLOAT;
+			dsvDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+			dsvDesc.Texture2DArray.FirstArraySlice = static_cast<UINT>(i);
+			dsvDesc.Texture2DArray.ArraySize = 1;
+
+			m_cascades[i].dsv = D3DResourceManager::Get().GetOrCreateDepthStencilView(name, m_shadowMapTex2D->GetTexture2D(), dsvDesc);
+			m_cascades[i].staticDSV = D3DResourceManager::Get().GetOrCreateDepthStencilView(L"Static" + name,
+				m_staticShadowMapTex2D->GetTexture2D(), dsvDesc);
+
+			D3D11_SHADER_RESOURCE_VIEW_DESC sliceSRVDesc = srvDesc;
+			sliceSRVDesc.Texture2DArray.FirstArraySlice = static_cast<UINT>(i);
+			sliceSRVDesc.Texture2DArray.ArraySize = 1;
+
+			m_cascades[i].srv = D3DResourceManager::Get().GetOrCreateShaderResourceView(name, m_shadowMapTex2D->GetTexture2D(), sliceSRVDesc);
+		}
+
 		D3D11_DEPTH_STENCIL_DESC depthStencilDesc{};
 		depthStencilDesc.DepthEnable = TRUE;
 		depthStencilDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
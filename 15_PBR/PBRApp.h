@@ -15,6 +15,8 @@
 #pragma comment(lib, "dxgi.lib")
 
 #include "../Common/ConstantBuffer.h"
+#include "../Common/TwoLevelBVH.h"
+#include "../Common/VisibilityCuller.h"
 
 #include "StaticMesh.h"
 #include "SkeletalMesh.h"
@@ -42,6 +44,38 @@ struct HDRConstant
 	float pad[2];
 };
 
+constexpr int MaxShadowCascadeCount = 4;
+
+// Shared.hlsli Cascade ۿ  ġ
+struct CascadeConstant
+{
+	DirectX::SimpleMath::Matrix viewProjection[MaxShadowCascadeCount];
+	// ĳ̵帶 ī޶    
+	float splitFar[MaxShadowCascadeCount];
+	int cascadeCount;
+	float pad[3];
+};
+
+// ī޶ ü     Ʈ  ϳ
+struct ShadowCascade
+{
+	DirectX::SimpleMath::Matrix projection;
+	// ĳ ø.       
+	DirectX::BoundingOrientedBox volume;
+	float splitFar = 0.0f;
+
+	std::shared_ptr<DepthStencilView> dsv;
+	std::shared_ptr<ShaderResourceView> srv;
+
+	//  ĳ͸ ׷ . Ʈ   ״θ   縸 
+	std::shared_ptr<DepthStencilView> staticDSV;
+	DirectX::SimpleMath::Matrix cachedViewProjection;
+	bool isStaticCacheValid = false;
+
+	VisibleList visibleStaticMeshes;
+	VisibleList visibleSkeletalMeshes;
+};
+
 class PBRApp :
 	public WinApp
 {
@@ -55,13 +89,16 @@ private:
 	std::shared_ptr<ConstantBuffer> m_overrideMatBuffer;
 	std::shared_ptr<ConstantBuffer> m_worldTransformBuffer;
 	std::shared_ptr<ConstantBuffer> m_hdrConstantBuffer;
+	std::shared_ptr<ConstantBuffer> m_cascadeConstantBuffer;
 
 	Microsoft::WRL::ComPtr<IDXGIAdapter3> m_dxgiAdapter;
 	Microsoft::WRL::ComPtr<IDXGIDevice3> m_dxgiDevice;
 
 	std::shared_ptr<Texture2D> m_shadowMapTex2D;
-	std::shared_ptr<DepthStencilView> m_shadowMapDSV;
+	// ĳ̵帶 ̽ ϳ ؽó 迭
 	std::shared_ptr<ShaderResourceView> m_shadowMapSRV;
+	std::shared_ptr<Texture2D> m_staticShadowMapTex2D;
+	ShadowCascade m_cascades[MaxShadowCascadeCount];
 	std::shared_ptr<RasterizerState> m_shadowMapRSS;
 	std::shared_ptr<DepthStencilState> m_shadowMapDSS;
 
@@ -88,6 +125,33 @@ private:
 	std::vector<StaticMesh> m_staticMeshes;
 	std::vector<SkeletalMesh> m_skeletalMeshes;
 
+	// ŷ 2ܰ BVH. ޽ ¸ ﰢ BVH ϳ, νϽ  BVH
+	TwoLevelBVH m_sceneBVH;
+	// m_staticMeshes  
+	std::vector<std::uint32_t> m_staticMeshInstanceIDs;
+	SceneRayHit m_pickHit;
+	int m_pickedMeshIndex = -1;
+
+	// ü ܰ. ޽ 迭 ÷ ϳ, н(ī޶, Ʈ) ̴  ϳ
+	VisibilityCuller m_staticMeshCuller;
+	VisibilityCuller m_skeletalMeshCuller;
+	VisibleList m_cameraVisibleStaticMeshes;
+	VisibleList m_cameraVisibleSkeletalMeshes;
+	std::vector<DirectX::BoundingBox> m_sectionBounds;
+
+	// ִϸ̼ LOD.   ø  ȭ   ٿ   
+	bool m_useAnimationLOD = true;
+	// Full, Half ܰ ּ ȭ ũ. ׺  Quarter
+	float m_animationLODScreenSizes[2]{ 0.3f, 0.1f };
+	int m_animationLODCounts[4]{};
+	// m_skeletalMeshes  . ī޶ ĳ̵忡  1
+	std::vector<std::uint8_t> m_skeletalMeshVisibility;
+	//  Ŭ,  ð νϽ ȷƮ 
+	bool m_useAnimationPoseCache = true;
+	std::uint32_t m_sharedAnimationPoseCount = 0;
+	// Ų ޽ø ̸  ȷƮ ؽó 
+	bool m_useBakedAnimation = false;
+
 	// Debug Draw
 	using VertexType = DirectX::VertexPositionColor;
 
@@ -98,8 +162,8 @@ private:
 
 	Matrix m_view;
 	Matrix m_projection;
+	// ȸ ִ Ʈ . ĳ̵尡  
 	Matrix m_lightView;
-	Matrix m_lightProjection;
 
 	Matrix m_lightRotationMatrix;
 	const Vector3 m_originalLightDir{ 0.0f, -1.0f, 0.0f };
@@ -108,20 +172,22 @@ private:
 	Vector4 m_lightColor{ 1.0f, 1.0f, 1.0f, 1.0f };
 	Vector4 m_ambientLightColor{ 0.1f, 0.1f, 0.1f, 1.0f };
 
-	Vector3 m_lightPosition;
-
 	OverrideMaterial m_overrideMaterialCB;
 	bool m_overrideMaterial = false;
 
 	HDRConstant m_hdrCB;
 
-	float m_lightNear = 90000.0f;
-	float m_lightFar = 100000.0f;
-	float m_lightFOV = 2.0f;
-	float m_lightForwardDistFromCam = 1000.0f;
 	float m_lightIntensity = 10.0f;
-	int m_shadowMapWidth = 8192;
-	int m_shadowMapHeight = 8192;
+	int m_cascadeCount = MaxShadowCascadeCount;
+	// ī޶󿡼  Ÿ ׸ڸ ׸
+	float m_shadowDistance = 3000.0f;
+	// 0̸ յ , 1̸ α 
+	float m_cascadeSplitLambda = 0.8f;
+	int m_shadowMapSize = 2048;
+	int m_shadowMapPreviewIndex = 0;
+	// ̹   ĳ͸ ٽ ׸ ĳ̵ 
+	int m_staticShadowRedrawCount = 0;
+	bool m_useStaticShadowCache = true;
 	int m_pcfSize = 1;
 	int m_hdriIndex = 2;
 	bool m_useShadowPCF = true;
@@ -138,7 +204,14 @@ private:
 	void OnRender() override;
 	void OnShutdown() override;
 
+	void CullScene();
+	// UpdateAll  ȣ. ø  ܰ迡 ϹǷ    
+	void UpdateAnimationLOD();
+	void UpdateShadowCascades();
+	//  ޽ø ߰ϰų ű  ȣ
+	void InvalidateStaticShadowCache();
 	void RenderShadowMap();
+	void DrawStaticShadowCasters(const VisibleList& visibleMeshes);
 	void RenderGeometryPass();
 	void RenderLightPass();
 	void RenderForwardPass();
@@ -6,7 +6,7 @@ Texture2D g_gBufferNormal : register(t2);
 Texture2D g_gBufferEmissive : register(t3);
 Texture2D g_gBufferORM : register(t4);
 
-Texture2D g_texShadowMap : register(t8);
+Texture2DArray g_texShadowMap : register(t8);
 TextureCube g_texIblIrradiance : register(t9);
 TextureCube g_texIblSpecular : register(t10);
 Texture2D g_texIBLSpecularBrdfLut : register(t11);
@@ -84,24 +84,33 @@ float4 main(PS_INPUT_QUAD input) : SV_Target
     float hDotV = max(0.0f, dot(h, v));
     
     // shadow
-    float4 lightClipPos = mul(float4(worldPos, 1.0f), g_lightViewProjection);
+    float viewDepth = mul(float4(worldPos, 1.0f), g_view).z;
     
-    float shadowFactor = 1.0f;
-    float currentShadowDepth = lightClipPos.z / lightClipPos.w;
-    float2 shadowMapUV = lightClipPos.xy / lightClipPos.w;
-    
-    shadowMapUV.y = -shadowMapUV.y;
-    shadowMapUV = shadowMapUV * 0.5f + 0.5f;
+    // ̰  ù ĳ̵.  ĳ̵庸 ָ ׸ 
+    int cascadeIndex = g_cascadeCount;
+    for (int i = 0; i < g_cascadeCount; ++i)
+    {
+        if (viewDepth <= g_cascadeSplits[i])
+        {
+            cascadeIndex = i;
+            break;
+        }
+    }
     
-    if (all(shadowMapUV >= 0.0f) && all(shadowMapUV <= 1.0f))
+    float shadowFactor = 1.0f;
+    if (cascadeIndex < g_cascadeCount)
     {
-        if (g_useShadowPCF)
+        float4 lightClipPos = mul(float4(worldPos, 1.0f), g_cascadeViewProjection[cascadeIndex]);
+        
+        float currentShadowDepth = lightClipPos.z / lightClipPos.w;
+        float2 shadowMapUV = lightClipPos.xy / lightClipPos.w;
+        
+        shadowMapUV.y = -shadowMapUV.y;
+        shadowMapUV = shadowMapUV * 0.5f + 0.5f;
+        
+        if (all(shadowMapUV >= 0.0f) && all(shadowMapUV <= 1.0f) && currentShadowDepth <= 1.0f)
         {
-            if (currentShadowDepth > 1.0f)
-            {
-                shadowFactor = 1.0f;
-            }
-            else
+            if (g_useShadowPCF)
             {
                 float texelSize = 1.0f / g_shadowMapSize;
 
@@ -112,24 +121,20 @@ float4 main(PS_INPUT_QUAD input) : SV_Target
                     for (int x = -max; x <= max; ++x)
                     {
                         float2 offset = float2(x, y) * texelSize;
-                        float2 sampleUV = shadowMapUV + offset;
+                        float3 sampleUV = float3(shadowMapUV + offset, cascadeIndex);
 
                         sum += g_texShadowMap.SampleCmpLevelZero(g_samComparison, sampleUV, currentShadowDepth - 0.0001f);
                     }
                 }
                 shadowFactor = sum / ((max * 2 + 1) * (max * 2 + 1));
             }
-        }
-        else
-        {
-            float sampleShadowDepth = g_texShadowMap.Sample(g_samLinear, shadowMapUV).r;
-            if (currentShadowDepth > 1.0f)
-            {
-                shadowFactor = 1.0f;
-            }
-            else if (currentShadowDepth > sampleShadowDepth + 0.001f)
+            else
             {
-                shadowFactor = 0.0f;
+                float sampleShadowDepth = g_texShadowMap.Sample(g_samLinear, float3(shadowMapUV, cascadeIndex)).r;
+                if (currentShadowDepth > sampleShadowDepth + 0.001f)
+                {
+                    shadowFactor = 0.0f;
+                }
             }
         }
     }
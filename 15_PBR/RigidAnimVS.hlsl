@@ -4,7 +4,7 @@ PS_INPUT_SHADOW main(VS_INPUT_COMMON input)
 {
     PS_INPUT_SHADOW output = (PS_INPUT_SHADOW) 0;
     
-    float4x4 world = mul(g_bonePose[g_refBoneIndex], g_world);
+    float4x4 world = mul(g_skinningPalette[g_paletteOffset + g_refBoneIndex], g_world);
     
     output.pos = mul(float4(input.pos, 1.0f), world);
     output.worldPos = output.pos.xyz;
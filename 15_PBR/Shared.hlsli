@@ -36,10 +36,8 @@ cbuffer Material : register(b2)
     float __pad2[3];
 }
 
-cbuffer BonePoseMatrix : register(b3)
-{
-    matrix g_bonePose[128];
-}
+// Ӹ  νϽ Ű   .  ̴ ̶ ȼ ̴ ؽó ԰ ġ ʴ ȣ
+StructuredBuffer<float4x4> g_skinningPalette : register(t12);
 
 cbuffer BoneOffsetMatrix : register(b4)
 {
@@ -50,7 +48,8 @@ cbuffer WorldTransform : register(b5)
 {
     matrix g_world;
     uint g_refBoneIndex;
-    float __pad1[3];
+    uint g_paletteOffset;
+    float2 __pad1;
 }
 
 cbuffer OverrideMaterial : register(b6)
@@ -68,6 +67,16 @@ cbuffer HDR : register(b7)
     float g_maxHDRNits;
 }
 
+#define MAX_CASCADE_COUNT 4
+
+cbuffer Cascade : register(b8)
+{
+    matrix g_cascadeViewProjection[MAX_CASCADE_COUNT];
+    float4 g_cascadeSplits; // ĳ̵帶    
+    int g_cascadeCount;
+    float3 __pad4;
+}
+
 struct VS_INPUT_SKINNING
 {
     float3 pos : POSITION;
@@ -8,6 +8,9 @@
 #include <queue>
 #include <unordered_map>
 #include <functional>
+#include <utility>
+#include <algorithm>
+#include <cassert>
 
 #include "../Common/Helper.h"
 #include "../Common/AssetManager.h"
@@ -22,13 +25,105 @@
 #include "../Common/PixelShader.h"
 #include "../Common/InputLayout.h"
 #include "../Common/SamplerState.h"
+#include "../Common/SkinningPaletteBuffer.h"
 #include "../Common/SkeletonData.h"
 #include "../Common/AnimationData.h"
+#include "../Common/BakedAnimationData.h"
+#include "../Common/ShaderResourceView.h"
 #include "../Common/MaterialHelper.h"
+#include "../Common/JobSystem.h"
 
 using DirectX::SimpleMath::Matrix;
 
+namespace
+{
+	//  ĳ ð .  ̺  ߳ νϽ   
+	constexpr float POSE_CACHE_TIME_STEP = 1.0f / 60.0f;
+
+	struct PoseCacheKey
+	{
+		const SkeletonData* skeleton;
+		const Animation* animation;
+		std::uint32_t timeStep;
+		// LOD  ֱ   ũ ޶  ð̾  ٸ
+		AnimationLOD lod;
+
+		bool operator==(const PoseCacheKey& other) const
+		{
+			return skeleton == other.skeleton && animation == other.animation && timeStep == other.timeStep && lod == other.lod;
+		}
+	};
+
+	struct PoseCacheKeyHash
+	{
+		size_t operator()(const PoseCacheKey& key) const
+		{
+			size_t hash = std::hash<const void*>{}(key.skeleton);
+			hash ^= std::hash<const void*>{}(key.animation) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			hash ^= std::hash<std::uint32_t>{}(key.timeStep) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			hash ^= std::hash<int>{}(static_cast<int>(key.lod)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			return hash;
+		}
+	};
+
+	//   ĳ. UpdateAll  Ŷ 
+	std::unordered_map<PoseCacheKey, const SkeletalMesh*, PoseCacheKeyHash> s_poseCache;
+	// BoneOffset  ۴ ũ  νϽ  .  ø ̷  ٽ ø 
+	const SkeletonData* s_uploadedBoneOffsets = nullptr;
+	// ̹  ȷƮ  ÷ȴ. Map   ȷƮ  νϽ ׸ 
+	bool s_isSkinningPaletteUploaded = false;
+	// Ű ȷƮ  ó 뷮. νϽ   Map Ű
+	constexpr UINT SKINNING_PALETTE_INITIAL_CAPACITY = static_cast<UINT>(MAX_BONE_NUM) * 64;
+
+	//  Ӹ Ŭ ϴ
+	std::uint32_t GetUpdateInterval(AnimationLOD lod)
+	{
+		switch (lod)
+		{
+		case AnimationLOD::Half:
+			return 2;
+		case AnimationLOD::Quarter:
+			return 4;
+		default:
+			return 1;
+		}
+	}
+
+	// S * R * T    ٷ . ȸ   ࿡  ϰ  ࿡ ġ 
+	DirectX::XMMATRIX XM_CALLCONV ComposeAffine(DirectX::FXMVECTOR translation, DirectX::FXMVECTOR rotation, DirectX::FXMVECTOR scale)
+	{
+		DirectX::XMMATRIX result = DirectX::XMMatrixRotationQuaternion(rotation);
+
+		result.r[0] = DirectX::XMVectorMultiply(result.r[0], DirectX::XMVectorSplatX(scale));
+		result.r[1] = DirectX::XMVectorMultiply(result.r[1], DirectX::XMVectorSplatY(scale));
+		result.r[2] = DirectX::XMVectorMultiply(result.r[2], DirectX::XMVectorSplatZ(scale));
+		result.r[3] = DirectX::XMVectorSelect(DirectX::g_XMIdentityR3, translation, DirectX::g_XMSelect1110);
+
+		return result;
+	}
+
+	//     (0, 0, 0, 1)  ̶ ึ 3x4 κи 
+	DirectX::XMMATRIX XM_CALLCONV MultiplyAffine(DirectX::FXMMATRIX a, DirectX::CXMMATRIX b)
+	{
+		DirectX::XMMATRIX result;
+
+		for (int i = 0; i < 3; ++i)
+		{
+			DirectX::XMVECTOR row = DirectX::XMVectorMultiply(DirectX::XMVectorSplatX(a.r[i]), b.r[0]);
+			row = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatY(a.r[i]), b.r[1], row);
+			result.r[i] = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatZ(a.r[i]), b.r[2], row);
+		}
+
+		DirectX::XMVECTOR row = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatX(a.r[3]), b.r[0], b.r[3]);
+		row = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatY(a.r[3]), b.r[1], row);
+		result.r[3] = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatZ(a.r[3]), b.r[2], row);
+
+		return result;
+	}
+}
+
 SkeletalMesh::SkeletalMesh(const std::wstring& filePath, const std::wstring& psFilePath)
+	: m_filePath{ filePath }
 {
 	m_skeletalMeshData = AssetManager::Get().GetOrCreateSkeletalMeshAsset(filePath);
 	m_materialData = AssetManager::Get().GetOrCreateMaterialAsset(filePath);
@@ -55,7 +150,7 @@ SkeletalMesh::SkeletalMesh(const std::wstring& filePath, const std::wstring& psF
 	m_indexBuffer = D3DResourceManager::Get().GetOrCreateIndexBuffer(filePath, m_skeletalMeshData->GetIndices());
 	m_materialBuffer = D3DResourceManager::Get().GetOrCreateConstantBuffer(L"Material", sizeof(MaterialBuffer));
 	m_worldTransformBuffer = D3DResourceManager::Get().GetOrCreateConstantBuffer(L"WorldTransform", sizeof(WorldTransformBuffer));
-	m_bonePoseBuffer = D3DResourceManager::Get().GetOrCreateConstantBuffer(L"BonePose", sizeof(Matrix) * MAX_BONE_NUM);
+	m_skinningPaletteBuffer = D3DResourceManager::Get().GetOrCreateSkinningPaletteBuffer(L"SkinningPalette", SKINNING_PALETTE_INITIAL_CAPACITY);
 	m_finalPassPixelShader = D3DResourceManager::Get().GetOrCreatePixelShader(psFilePath);
 	m_shadowPassPixelShader = D3DResourceManager::Get().GetOrCreatePixelShader(L"LightViewPS.hlsl");
 
@@ -110,6 +205,14 @@ SkeletalMesh::SkeletalMesh(const std::wstring& filePath, const std::wstring& psF
 
 	// νϽ  
 	m_skeletonData->SetupSkeletonInstance(m_skeleton);
+	AnimationPose::SetupBindPose(m_skeleton, m_bindPose);
+	m_pose = m_bindPose;
+	m_scratchPose = m_bindPose;
+
+	if (!m_skeletalMeshData->IsRigid())
+	{
+		m_boneLODMask = &m_skeletonData->GetLeafLODMask();
+	}
 }
 
 void SkeletalMesh::SetWorld(const Matrix& world) 
@@ -123,47 +226,537 @@ void SkeletalMesh::SetPixelShader(const std::wstring& filePath)
 }
 
 void SkeletalMesh::Update(float deltaTime)
+{
+	if (m_animationLOD == AnimationLOD::Frozen)
+	{
+		return;
+	}
+
+	//  ð  ȣ . ø ٿ    AABB ϹǷ ȷƮ  
+	if (IsBakedAnimationActive())
+	{
+		const Animation& animation = m_animationData->GetAnimations()[m_basePlayback.index];
+		m_basePlayback.Advance(animation, m_pendingDeltaTime + deltaTime);
+		m_pendingDeltaTime = 0.0f;
+
+		const BakedAnimationFrame frame = m_bakedAnimationData->FindFrame(m_basePlayback.index, m_basePlayback.time);
+		m_bakedAnimationCB.frameRow0 = frame.row0;
+		m_bakedAnimationCB.frameRow1 = frame.row1;
+		m_bakedAnimationCB.frameLerp = frame.lerp;
+
+		return;
+	}
+
+	const std::uint32_t updateInterval = GetUpdateInterval(m_animationLOD);
+
+	// Owner  ð PreparePoseCache ̹ 
+	if (m_poseCacheState != PoseCacheState::Owner)
+	{
+		m_pendingDeltaTime += deltaTime;
+	}
+
+	if (m_framesSinceEvaluate == 0)
+	{
+		const BoneMask* boneMask = m_animationLOD == AnimationLOD::Quarter ? m_boneLODMask : nullptr;
+
+		if (updateInterval == 1)
+		{
+			EvaluateScheduledPose(boneMask, m_pose);
+		}
+		else
+		{
+			//  ̴     򰡱  Ѿ.  ֱ  Ƣ 
+			m_fromPose = m_pose;
+			EvaluateScheduledPose(boneMask, m_targetPose);
+
+			// ø ǳʶ   ε  Ƣ ʰ  ̴  ״ 
+			if (boneMask != nullptr)
+			{
+				AnimationPose::CopyMasked(m_fromPose, *boneMask, m_targetPose);
+			}
+		}
+	}
+
+	if (updateInterval > 1)
+	{
+		const float alpha = static_cast<float>(m_framesSinceEvaluate + 1) / updateInterval;
+		AnimationPose::Blend(m_fromPose, m_targetPose, alpha, m_pose);
+	}
+
+	m_framesSinceEvaluate = (m_framesSinceEvaluate + 1) % updateInterval;
+
+	UpdateSkeletonPose();
+}
+
+void SkeletalMesh::EvaluateScheduledPose(const BoneMask* boneMask, PoseBuffer& out)
+{
+	if (m_poseCacheState == PoseCacheState::Owner)
+	{
+		const Animation& animation = m_animationData->GetAnimations()[m_basePlayback.index];
+		AnimationPose::Sample(animation, m_poseCacheSampleTime, m_bindPose, m_basePlayback.cursors, out, boneMask);
+	}
+	else
+	{
+		EvaluatePose(m_pendingDeltaTime, boneMask, out);
+	}
+
+	m_pendingDeltaTime = 0.0f;
+}
+
+void SkeletalMesh::EvaluatePose(float deltaTime, const BoneMask* boneMask, PoseBuffer& out)
 {
 	const auto& animations = m_animationData->GetAnimations();
 
-	if (!animations.empty())
+	if (m_basePlayback.IsPlaying())
+	{
+		const Animation& animation = animations[m_basePlayback.index];
+		m_basePlayback.Advance(animation, deltaTime);
+		AnimationPose::Sample(animation, m_basePlayback.time, m_bindPose, m_basePlayback.cursors, out, boneMask);
+	}
+	else
 	{
-		m_animationProgressTime += deltaTime;
-		m_animationProgressTime = std::fmod(m_animationProgressTime, animations[m_animationIndex].duration);
+		out = m_bindPose;
 	}
 
-	for (auto& bone : m_skeleton)
+	if (m_fadeOutPlayback.IsPlaying())
 	{
-		if (bone.boneAnimation != nullptr)
+		m_crossfadeTime += deltaTime;
+
+		if (m_crossfadeTime >= m_crossfadeDuration)
+		{
+			m_fadeOutPlayback.Stop();
+		}
+		else
 		{
-			DirectX::SimpleMath::Vector3 position, scale;
-			DirectX::SimpleMath::Quaternion rotation;
-			bone.boneAnimation->Evaluate(m_animationProgressTime, bone.lastKeyIndex, position, rotation, scale);
-			bone.local = Matrix::CreateScale(scale) * Matrix::CreateFromQuaternion(rotation) * Matrix::CreateTranslation(position);
+			const Animation& animation = animations[m_fadeOutPlayback.index];
+			m_fadeOutPlayback.Advance(animation, deltaTime);
+			AnimationPose::Sample(animation, m_fadeOutPlayback.time, m_bindPose, m_fadeOutPlayback.cursors, m_scratchPose, boneMask);
+			AnimationPose::Blend(m_scratchPose, out, m_crossfadeTime / m_crossfadeDuration, out);
 		}
+	}
+
+	if (m_layerPlayback.IsPlaying())
+	{
+		const Animation& animation = animations[m_layerPlayback.index];
+		m_layerPlayback.Advance(animation, deltaTime);
+		AnimationPose::Sample(animation, m_layerPlayback.time, m_bindPose, m_layerPlayback.cursors, m_scratchPose, boneMask);
+		AnimationPose::BlendMasked(out, m_scratchPose, m_layerMask, m_layerWeight, out);
+	}
 
+	if (m_additivePlayback.IsPlaying())
+	{
+		const Animation& animation = animations[m_additivePlayback.index];
+		m_additivePlayback.Advance(animation, deltaTime);
+		AnimationPose::Sample(animation, m_additivePlayback.time, m_bindPose, m_additivePlayback.cursors, m_scratchPose, boneMask);
+		AnimationPose::AddAdditive(out, m_scratchPose, m_additiveReferencePose, m_additiveWeight, out);
+	}
+}
+
+void SkeletalMesh::UpdateSkeletonPose()
+{
+	// m_skeleton θ ׻ ڽĺ տ ִ     
+	for (auto& bone : m_skeleton)
+	{
+		const DirectX::XMMATRIX local = ComposeAffine(DirectX::XMLoadFloat3(&m_pose.translations[bone.index]),
+			DirectX::XMLoadFloat4(&m_pose.rotations[bone.index]), DirectX::XMLoadFloat3(&m_pose.scales[bone.index]));
+		DirectX::XMStoreFloat4x4(&bone.local, local);
+
+		DirectX::XMMATRIX model = local;
 		if (bone.parentIndex != -1)
 		{
-			bone.model = bone.local * m_skeleton[bone.parentIndex].model;
+			const DirectX::XMMATRIX parentModel = DirectX::XMLoadFloat4x4(&m_skeleton[bone.parentIndex].model);
+			model = MultiplyAffine(local, parentModel);
+		}
+
+		DirectX::XMStoreFloat4x4(&bone.model, model);
+		// ̴ д ġ ġ ٷ 
+		DirectX::XMStoreFloat4x4(&m_skeletonPose[bone.index], DirectX::XMMatrixTranspose(model));
+	}
+}
+
+std::uint32_t SkeletalMesh::UpdateAll(std::vector<SkeletalMesh>& meshes, float deltaTime, bool usePoseCache)
+{
+	s_poseCache.clear();
+	std::uint32_t sharerCount = 0;
+
+	// Ű   ؾ Owner ϳ Ƿ . Ű 길 ϹǷ δ
+	for (auto& mesh : meshes)
+	{
+		mesh.m_poseCacheState = PoseCacheState::None;
+		mesh.m_poseCacheOwner = nullptr;
+
+		std::uint32_t timeStep = 0;
+		if (!usePoseCache || !mesh.PreparePoseCache(deltaTime, timeStep))
+		{
+			continue;
+		}
+
+		const PoseCacheKey key{ mesh.m_skeletonData.get(), &mesh.m_animationData->GetAnimations()[mesh.m_basePlayback.index], timeStep, mesh.m_animationLOD };
+		const auto [it, inserted] = s_poseCache.try_emplace(key, &mesh);
+
+		if (inserted)
+		{
+			mesh.m_poseCacheState = PoseCacheState::Owner;
 		}
 		else
 		{
-			bone.model = bone.local;
+			mesh.m_poseCacheState = PoseCacheState::Sharer;
+			mesh.m_poseCacheOwner = it->second;
+			++sharerCount;
 		}
+	}
 
-		m_skeletonPose[bone.index] = bone.model.Transpose();
+	JobSystem::Get().ParallelFor(static_cast<std::uint32_t>(meshes.size()), JobSystem::DEFAULT_BATCH_SIZE,
+		[&meshes, deltaTime](std::uint32_t begin, std::uint32_t end)
+		{
+			for (std::uint32_t i = begin; i < end; ++i)
+			{
+				if (meshes[i].m_poseCacheState != PoseCacheState::Sharer)
+				{
+					meshes[i].Update(deltaTime);
+				}
+			}
+		});
+
+	if (sharerCount > 0)
+	{
+		//   ĳÿ ų Owner ŵ ڱ  ̾ ޾ .
+		// LOD Ƿ  ֱ    ޾Ƽ 򰡸 ǳʶٴ ӿ Owner  ִ  ״ ̾ 
+		JobSystem::Get().ParallelFor(static_cast<std::uint32_t>(meshes.size()), JobSystem::DEFAULT_BATCH_SIZE,
+			[&meshes](std::uint32_t begin, std::uint32_t end)
+			{
+				for (std::uint32_t i = begin; i < end; ++i)
+				{
+					SkeletalMesh& mesh = meshes[i];
+					if (mesh.m_poseCacheState != PoseCacheState::Sharer)
+					{
+						continue;
+					}
+
+					const SkeletalMesh& owner = *mesh.m_poseCacheOwner;
+					mesh.m_pose = owner.m_pose;
+					mesh.m_skeletonPose = owner.m_skeletonPose;
+					mesh.m_framesSinceEvaluate = owner.m_framesSinceEvaluate;
+
+					if (GetUpdateInterval(mesh.m_animationLOD) > 1)
+					{
+						mesh.m_fromPose = owner.m_fromPose;
+						mesh.m_targetPose = owner.m_targetPose;
+					}
+				}
+			});
 	}
+
+	return sharerCount;
 }
 
-void SkeletalMesh::PlayAnimation(size_t index)
+void SkeletalMesh::UploadSkinningPalettes(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext, std::vector<SkeletalMesh>& meshes)
 {
-	m_animationIndex = index;
-	m_animationProgressTime = 0.0f;
-	m_animationData->GetAnimations()[index].SetupBoneAnimation(m_skeleton);
+	s_uploadedBoneOffsets = nullptr;
+	s_isSkinningPaletteUploaded = true;
+
+	if (meshes.empty())
+	{
+		return;
+	}
+
+	//   Sharer Owner  ãƾ ϹǷ . Owner UpdateAll Ű  ׻ Sharer տ 
+	UINT matrixCount = 0;
+	for (auto& mesh : meshes)
+	{
+		if (mesh.IsBakedAnimationActive())
+		{
+			continue;
+		}
+
+		if (mesh.m_poseCacheState == PoseCacheState::Sharer)
+		{
+			mesh.m_worldTransformCB.paletteOffset = mesh.m_poseCacheOwner->m_worldTransformCB.paletteOffset;
+			continue;
+		}
+
+		mesh.m_worldTransformCB.paletteOffset = matrixCount;
+		matrixCount += static_cast<UINT>(std::min(mesh.m_skeleton.size(), MAX_BONE_NUM));
+	}
+
+	if (matrixCount == 0)
+	{
+		return;
+	}
+
+	SkinningPaletteBuffer& paletteBuffer = *meshes.front().m_skinningPaletteBuffer;
+	Matrix* palette = paletteBuffer.Map(deviceContext, matrixCount);
+	if (palette == nullptr)
+	{
+		//   ̳ ٸ  а ǹǷ ׸ ʴ  
+		assert(false && "Skinning palette map failed");
+		s_isSkinningPaletteUploaded = false;
+		return;
+	}
+
+	// νϽ  ġ Ƿ  . WRITE_DISCARD  ޸𸮶  ʰ ⸸ 
+	JobSystem::Get().ParallelFor(static_cast<std::uint32_t>(meshes.size()), JobSystem::DEFAULT_BATCH_SIZE,
+		[&meshes, palette](std::uint32_t begin, std::uint32_t end)
+		{
+			for (std::uint32_t i = begin; i < end; ++i)
+			{
+				const SkeletalMesh& mesh = meshes[i];
+				if (mesh.IsBakedAnimationActive() || mesh.m_poseCacheState == PoseCacheState::Sharer)
+				{
+					continue;
+				}
+
+				const size_t boneCount = std::min(mesh.m_skeleton.size(), MAX_BONE_NUM);
+				Matrix* out = palette + mesh.m_worldTransformCB.paletteOffset;
+
+				//  ޽ô   ϳ Ƿ   
+				if (mesh.m_skeletalMeshData->IsRigid())
+				{
+					std::copy_n(mesh.m_skeletonPose.begin(), boneCount, out);
+					continue;
+				}
+
+				//   ġ  ̶ pose^T * offset^T == (offset * pose)^T
+				const auto& boneOffsets = mesh.m_skeletonData->GetBoneOffsets();
+				for (size_t j = 0; j < boneCount; ++j)
+				{
+					DirectX::XMStoreFloat4x4(&out[j], DirectX::XMMatrixMultiply(
+						DirectX::XMLoadFloat4x4(&mesh.m_skeletonPose[j]), DirectX::XMLoadFloat4x4(&boneOffsets[j])));
+				}
+			}
+		});
+
+	paletteBuffer.Unmap(deviceContext);
+}
+
+bool SkeletalMesh::IsBakedAnimationActive() const
+{
+	return m_useBakedAnimation && m_basePlayback.IsPlaying();
+}
+
+void SkeletalMesh::BindBonePose(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext)
+{
+	if (IsBakedAnimationActive())
+	{
+		deviceContext->VSSetShaderResources(0, 1, m_bakedAnimationSRV->GetShaderResourceView().GetAddressOf());
+		deviceContext->VSSetConstantBuffers(static_cast<UINT>(ConstantBufferSlot::BakedAnimation),
+			1, m_bakedAnimationBuffer->GetBuffer().GetAddressOf());
+		deviceContext->UpdateSubresource(m_bakedAnimationBuffer->GetRawBuffer(), 0, nullptr, &m_bakedAnimationCB, 0, 0);
+
+		// ũ ؽó  ϱ   ̴ 
+		deviceContext->VSSetConstantBuffers(static_cast<UINT>(ConstantBufferSlot::BoneOffsetMatrix),
+			1, m_boneOffsetBuffer->GetBuffer().GetAddressOf());
+		if (m_skeletonData.get() != s_uploadedBoneOffsets)
+		{
+			deviceContext->UpdateSubresource(m_boneOffsetBuffer->GetRawBuffer(), 0, nullptr, m_skeletonData->GetBoneOffsets().data(), 0, 0);
+			s_uploadedBoneOffsets = m_skeletonData.get();
+		}
+
+		return;
+	}
+
+	deviceContext->VSSetShaderResources(12, 1, m_skinningPaletteBuffer->GetShaderResourceView().GetAddressOf());
+}
+
+const BoneMatrixArray& SkeletalMesh::GetSkeletonPose() const
+{
+	if (m_poseCacheState == PoseCacheState::Sharer)
+	{
+		return m_poseCacheOwner->m_skeletonPose;
+	}
+
+	return m_skeletonPose;
+}
+
+bool SkeletalMesh::PreparePoseCache(float deltaTime, std::uint32_t& outTimeStep)
+{
+	if (m_animationLOD == AnimationLOD::Frozen || IsBakedAnimationActive() || !m_basePlayback.IsPlaying() || m_fadeOutPlayback.IsPlaying() ||
+		m_layerPlayback.IsPlaying() || m_additivePlayback.IsPlaying())
+	{
+		return false;
+	}
+
+	// LOD з ִ ð   
+	const Animation& animation = m_animationData->GetAnimations()[m_basePlayback.index];
+	m_basePlayback.Advance(animation, m_pendingDeltaTime + deltaTime);
+	m_pendingDeltaTime = 0.0f;
+
+	outTimeStep = static_cast<std::uint32_t>(m_basePlayback.time / POSE_CACHE_TIME_STEP);
+	m_poseCacheSampleTime = outTimeStep * POSE_CACHE_TIME_STEP;
+
+	return true;
+}
+
+bool SkeletalMesh::SetUseBakedAnimation(bool useBakedAnimation)
+{
+	if (!useBakedAnimation || m_skeletalMeshData->IsRigid())
+	{
+		m_useBakedAnimation = false;
+
+		return false;
+	}
+
+	if (m_bakedAnimationData == nullptr)
+	{
+		std::shared_ptr<BakedAnimationData> bakedAnimationData = AssetManager::Get().GetOrCreateBakedAnimationAsset(m_filePath);
+
+		//  ؽó  Ŭ η Ƿ    CPU η 
+		if (bakedAnimationData->GetHeight() == 0 || bakedAnimationData->GetHeight() > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+		{
+			m_useBakedAnimation = false;
+
+			return false;
+		}
+
+		D3D11_TEXTURE2D_DESC texDesc{};
+		texDesc.Width = bakedAnimationData->GetWidth();
+		texDesc.Height = bakedAnimationData->GetHeight();
+		texDesc.MipLevels = 1;
+		texDesc.ArraySize = 1;
+		texDesc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+		texDesc.SampleDesc.Count = 1;
+		texDesc.Usage = D3D11_USAGE_IMMUTABLE;
+		texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+		D3D11_SUBRESOURCE_DATA subData{};
+		subData.pSysMem = bakedAnimationData->GetTexels().data();
+		subData.SysMemPitch = bakedAnimationData->GetWidth() * sizeof(DirectX::XMFLOAT4);
+
+		m_bakedAnimationData = bakedAnimationData;
+		m_bakedAnimationSRV = D3DResourceManager::Get().GetOrCreateShaderResourceView(m_filePath + L"_BakedAnimation", texDesc, subData);
+		m_bakedAnimationBuffer = D3DResourceManager::Get().GetOrCreateConstantBuffer(L"BakedAnimation", sizeof(BakedAnimationBuffer));
+		m_bakedFinalPassVertexShader = D3DResourceManager::Get().GetOrCreateVertexShader(L"SkinningBakedAnimVS.hlsl");
+		m_bakedShadowPassVertexShader = D3DResourceManager::Get().GetOrCreateVertexShader(L"SkinningBakedAnimLightViewVS.hlsl");
+	}
+
+	m_useBakedAnimation = true;
+
+	return true;
+}
+
+void SkeletalMesh::SetAnimationLOD(AnimationLOD lod)
+{
+	if (m_animationLOD != lod)
+	{
+		m_animationLOD = lod;
+		m_framesSinceEvaluate = 0;
+	}
+}
+
+AnimationLOD SkeletalMesh::GetAnimationLOD() const
+{
+	return m_animationLOD;
 }
 
-void SkeletalMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext)
+void SkeletalMesh::PlayAnimation(size_t index, float crossfadeDuration)
 {
+	// ̵ ߿ ٽ Ҹ ̴  Ŭ   Ŭ  Ѿ
+	if (crossfadeDuration > 0.0f && m_basePlayback.IsPlaying())
+	{
+		std::swap(m_fadeOutPlayback, m_basePlayback);
+		m_crossfadeDuration = crossfadeDuration;
+		m_crossfadeTime = 0.0f;
+	}
+	else
+	{
+		m_fadeOutPlayback.Stop();
+	}
+
+	m_basePlayback.Start(index);
+}
+
+void SkeletalMesh::SetLayerAnimation(size_t index, const std::wstring& rootBoneName, float weight)
+{
+	if (m_layerPlayback.index != index)
+	{
+		m_layerPlayback.Start(index);
+	}
+
+	m_layerMask = BoneMask::CreateFromRoot(m_skeleton, rootBoneName);
+	m_layerWeight = weight;
+}
+
+void SkeletalMesh::StopLayerAnimation()
+{
+	m_layerPlayback.Stop();
+}
+
+void SkeletalMesh::SetAdditiveAnimation(size_t index, float weight)
+{
+	if (m_additivePlayback.index != index)
+	{
+		m_additivePlayback.Start(index);
+
+		std::vector<LastKeyIndex> cursors;
+		AnimationPose::Sample(m_animationData->GetAnimations()[index], 0.0f, m_bindPose, cursors, m_additiveReferencePose);
+	}
+
+	m_additiveWeight = weight;
+}
+
+void SkeletalMesh::StopAdditiveAnimation()
+{
+	m_additivePlayback.Stop();
+}
+
+void SkeletalMesh::CalculateWorldBounds(std::vector<DirectX::BoundingBox>& outSectionBounds) const
+{
+	const auto& meshSections = m_skeletalMeshData->GetMeshSections();
+	const Matrix world = m_worldTransformCB.world.Transpose();
+
+	if (IsBakedAnimationActive())
+	{
+		const BakedAnimationFrame frame{ m_bakedAnimationCB.frameRow0, m_bakedAnimationCB.frameRow1, m_bakedAnimationCB.frameLerp };
+		m_bakedAnimationData->CalculateSectionBounds(frame, world, outSectionBounds);
+
+		return;
+	}
+
+	const BoneMatrixArray& skeletonPose = GetSkeletonPose();
+
+	outSectionBounds.resize(meshSections.size());
+
+	for (size_t i = 0; i < meshSections.size(); ++i)
+	{
+		const auto& meshSection = meshSections[i];
+
+		if (m_skeletalMeshData->IsRigid())
+		{
+			meshSection.bounds.Transform(outSectionBounds[i], skeletonPose[meshSection.m_boneReference].Transpose() * world);
+
+			continue;
+		}
+
+		// boneBounds     ״
+		outSectionBounds[i] = DirectX::BoundingBox(world.Translation(), DirectX::SimpleMath::Vector3::Zero);
+
+		for (size_t j = 0; j < meshSection.boneBounds.size(); ++j)
+		{
+			const BoneBounds& boneBounds = meshSection.boneBounds[j];
+
+			DirectX::BoundingBox bounds;
+			boneBounds.bounds.Transform(bounds, skeletonPose[boneBounds.boneIndex].Transpose() * world);
+
+			if (j == 0)
+			{
+				outSectionBounds[i] = bounds;
+			}
+			else
+			{
+				DirectX::BoundingBox::CreateMerged(outSectionBounds[i], outSectionBounds[i], bounds);
+			}
+		}
+	}
+}
+
+void SkeletalMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext,
+	const std::uint32_t* sectionIndices, std::uint32_t sectionCount)
+{
+	if (!IsBakedAnimationActive() && !s_isSkinningPaletteUploaded)
+	{
+		return;
+	}
+
 	static const UINT s_vertexBufferOffset = 0;
 	const UINT s_vertexBufferStride = m_vertexBuffer->GetBufferStride();
 
@@ -171,12 +764,11 @@ void SkeletalMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& devic
 	deviceContext->IASetIndexBuffer(m_indexBuffer->GetRawBuffer(), DXGI_FORMAT_R32_UINT, 0);
 	deviceContext->IASetInputLayout(m_inputLayout->GetRawInputLayout());
 
-	deviceContext->VSSetShader(m_finalPassVertexShader->GetRawShader(), nullptr, 0);
+	const auto& vertexShader = IsBakedAnimationActive() ? m_bakedFinalPassVertexShader : m_finalPassVertexShader;
+	deviceContext->VSSetShader(vertexShader->GetRawShader(), nullptr, 0);
 	deviceContext->VSSetConstantBuffers(static_cast<UINT>(ConstantBufferSlot::WorldTransform),
 		1, m_worldTransformBuffer->GetBuffer().GetAddressOf());
-	deviceContext->VSSetConstantBuffers(static_cast<UINT>(ConstantBufferSlot::BonePoseMatrix),
-		1, m_bonePoseBuffer->GetBuffer().GetAddressOf());
-	deviceContext->UpdateSubresource(m_bonePoseBuffer->GetRawBuffer(), 0, nullptr, m_skeletonPose.data(), 0, 0);
+	BindBonePose(deviceContext);
 
 	deviceContext->PSSetSamplers(0, 1, m_samplerState->GetSamplerState().GetAddressOf());
 	deviceContext->PSSetSamplers(1, 1, m_comparisonSamplerState->GetSamplerState().GetAddressOf());
@@ -188,8 +780,9 @@ void SkeletalMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& devic
 
 	if (m_skeletalMeshData->IsRigid())
 	{
-		for (const auto& meshSection : meshSections)
+		for (std::uint32_t i = 0; i < sectionCount; ++i)
 		{
+			const auto& meshSection = meshSections[sectionIndices[i]];
 			m_worldTransformCB.refBoneIndex = meshSection.m_boneReference;
 			deviceContext->UpdateSubresource(m_worldTransformBuffer->GetRawBuffer(), 0, nullptr, &m_worldTransformCB, 0, 0);
 
@@ -202,13 +795,11 @@ void SkeletalMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& devic
 	}
 	else
 	{
-		deviceContext->VSSetConstantBuffers(static_cast<UINT>(ConstantBufferSlot::BoneOffsetMatrix),
-			1, m_boneOffsetBuffer->GetBuffer().GetAddressOf());
 		deviceContext->UpdateSubresource(m_worldTransformBuffer->GetRawBuffer(), 0, nullptr, &m_worldTransformCB, 0, 0);
-		deviceContext->UpdateSubresource(m_boneOffsetBuffer->GetRawBuffer(), 0, nullptr, m_skeletonData->GetBoneOffsets().data(), 0, 0);
 
-		for (const auto& meshSection : meshSections)
+		for (std::uint32_t i = 0; i < sectionCount; ++i)
 		{
+			const auto& meshSection = meshSections[sectionIndices[i]];
 			const auto textureSRVs = m_textureSRVs[meshSection.materialIndex].AsRawArray();
 
 			deviceContext->PSSetShaderResources(0, static_cast<UINT>(textureSRVs.size()), textureSRVs.data());
@@ -218,8 +809,14 @@ void SkeletalMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& devic
 	}
 }
 
-void SkeletalMesh::DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext)
+void SkeletalMesh::DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext,
+	const std::uint32_t* sectionIndices, std::uint32_t sectionCount)
 {
+	if (!IsBakedAnimationActive() && !s_isSkinningPaletteUploaded)
+	{
+		return;
+	}
+
 	static const UINT s_vertexBufferOffset = 0;
 	const UINT s_vertexBufferStride = m_vertexBuffer->GetBufferStride();
 
@@ -227,12 +824,11 @@ void SkeletalMesh::DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContex
 	deviceContext->IASetIndexBuffer(m_indexBuffer->GetRawBuffer(), DXGI_FORMAT_R32_UINT, 0);
 	deviceContext->IASetInputLayout(m_inputLayout->GetRawInputLayout());
 
-	deviceContext->VSSetShader(m_shadowPassVertexShader->GetRawShader(), nullptr, 0);
+	const auto& vertexShader = IsBakedAnimationActive() ? m_bakedShadowPassVertexShader : m_shadowPassVertexShader;
+	deviceContext->VSSetShader(vertexShader->GetRawShader(), nullptr, 0);
 	deviceContext->VSSetConstantBuffers(static_cast<UINT>(ConstantBufferSlot::WorldTransform),
 		1, m_worldTransformBuffer->GetBuffer().GetAddressOf());
-	deviceContext->VSSetConstantBuffers(static_cast<UINT>(ConstantBufferSlot::BonePoseMatrix),
-		1, m_bonePoseBuffer->GetBuffer().GetAddressOf());
-	deviceContext->UpdateSubresource(m_bonePoseBuffer->GetRawBuffer(), 0, nullptr, m_skeletonPose.data(), 0, 0);
+	BindBonePose(deviceContext);
 
 	deviceContext->PSSetSamplers(0, 1, m_samplerState->GetSamplerState().GetAddressOf());
 	deviceContext->PSSetShader(m_shadowPassPixelShader->GetRawShader(), nullptr, 0);
@@ -241,8 +837,9 @@ void SkeletalMesh::DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContex
 
 	if (m_skeletalMeshData->IsRigid())
 	{
-		for (const auto& meshSection : meshSections)
+		for (std::uint32_t i = 0; i < sectionCount; ++i)
 		{
+			const auto& meshSection = meshSections[sectionIndices[i]];
 			auto textureSRV = m_textureSRVs[meshSection.materialIndex].opacityTextureSRV;
 
 			deviceContext->PSSetShaderResources(0, 1, textureSRV->GetShaderResourceView().GetAddressOf());
@@ -255,13 +852,11 @@ void SkeletalMesh::DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContex
 	}
 	else
 	{
-		deviceContext->VSSetConstantBuffers(static_cast<UINT>(ConstantBufferSlot::BoneOffsetMatrix),
-			1, m_boneOffsetBuffer->GetBuffer().GetAddressOf());
 		deviceContext->UpdateSubresource(m_worldTransformBuffer->GetRawBuffer(), 0, nullptr, &m_worldTransformCB, 0, 0);
-		deviceContext->UpdateSubresource(m_boneOffsetBuffer->GetRawBuffer(), 0, nullptr, m_skeletonData->GetBoneOffsets().data(), 0, 0);
 
-		for (const auto& meshSection : meshSections)
+		for (std::uint32_t i = 0; i < sectionCount; ++i)
 		{
+			const auto& meshSection = meshSections[sectionIndices[i]];
 			auto textureSRV = m_textureSRVs[meshSection.materialIndex].opacityTextureSRV;
 
 			deviceContext->PSSetShaderResources(0, 1, textureSRV->GetShaderResourceView().GetAddressOf());
@@ -4,14 +4,18 @@
 #include <vector>
 #include <directxtk/SimpleMath.h>
 #include <memory>
+#include <cstdint>
+#include <DirectXCollision.h>
 
 #include "../Common/ShaderConstant.h"
 #include "../Common/ShaderResourceView.h"
 #include "../Common/SkeletonData.h"
+#include "../Common/AnimationPose.h"
 
 class SkeletalMeshData;
 class MaterialData;
 class AnimationData;
+class BakedAnimationData;
 
 class VertexBuffer;
 class IndexBuffer;
@@ -21,24 +25,43 @@ class PixelShader;
 class ShaderResourceView;
 class InputLayout;
 class SamplerState;
+class SkinningPaletteBuffer;
 
 struct aiNode;
 
+// ִϸ̼  ܰ. ȭ鿡  Ʒ ܰ
+enum class AnimationLOD
+{
+	Full,		//  
+	Half,		// 2Ӹ ϰ ̴ 
+	Quarter,	// 4Ӹ ϰ   ø 
+	Frozen,		//  .   ð ״ 
+};
+
 class SkeletalMesh
 {
 private:
+	enum class PoseCacheState
+	{
+		None,
+		Owner,		// ̹   Ű  ǥ 
+		Sharer,		//  Ű  Owner ȷƮ ״ 
+	};
+
 	// assets
+	std::wstring m_filePath;
 	std::shared_ptr<SkeletalMeshData> m_skeletalMeshData;
 	std::shared_ptr<MaterialData> m_materialData;
 	std::shared_ptr<AnimationData> m_animationData;
 	std::shared_ptr<SkeletonData> m_skeletonData;
+	// ũ 带 ó   
+	std::shared_ptr<BakedAnimationData> m_bakedAnimationData;
 
 	// resources
 	std::shared_ptr<VertexBuffer> m_vertexBuffer;
 	std::shared_ptr<IndexBuffer> m_indexBuffer;
 	std::shared_ptr<ConstantBuffer> m_materialBuffer;
 	std::shared_ptr<ConstantBuffer> m_worldTransformBuffer;
-	std::shared_ptr<ConstantBuffer> m_bonePoseBuffer;
 	std::shared_ptr<ConstantBuffer> m_boneOffsetBuffer;
 	std::shared_ptr<VertexShader> m_finalPassVertexShader;
 	std::shared_ptr<VertexShader> m_shadowPassVertexShader;
@@ -48,14 +71,50 @@ private:
 	std::shared_ptr<InputLayout> m_inputLayout;
 	std::shared_ptr<SamplerState> m_samplerState;
 	std::shared_ptr<SamplerState> m_comparisonSamplerState;
+	std::shared_ptr<SkinningPaletteBuffer> m_skinningPaletteBuffer;
+	std::shared_ptr<ShaderResourceView> m_bakedAnimationSRV;
+	std::shared_ptr<ConstantBuffer> m_bakedAnimationBuffer;
+	std::shared_ptr<VertexShader> m_bakedFinalPassVertexShader;
+	std::shared_ptr<VertexShader> m_bakedShadowPassVertexShader;
 
 	// instance
 	std::vector<MaterialBuffer> m_materialCBs;
 	WorldTransformBuffer m_worldTransformCB;
 	std::vector<Bone> m_skeleton;
 	BoneMatrixArray m_skeletonPose;
-	size_t m_animationIndex = 0;
-	float m_animationProgressTime = 0.0f;
+
+	// animation. Ŭ  ۷ øؼ    꿡   ķ ٲ
+	PoseBuffer m_bindPose;
+	PoseBuffer m_pose;
+	PoseBuffer m_scratchPose;
+	AnimationPlayback m_basePlayback;
+	AnimationPlayback m_fadeOutPlayback;
+	float m_crossfadeDuration = 0.0f;
+	float m_crossfadeTime = 0.0f;
+	AnimationPlayback m_layerPlayback;
+	BoneMask m_layerMask;
+	float m_layerWeight = 0.0f;
+	AnimationPlayback m_additivePlayback;
+	PoseBuffer m_additiveReferencePose;
+	float m_additiveWeight = 0.0f;
+
+	// animation LOD. 򰡸 ǳʶٴ  m_fromPose m_targetPose 
+	AnimationLOD m_animationLOD = AnimationLOD::Full;
+	std::uint32_t m_framesSinceEvaluate = 0;
+	float m_pendingDeltaTime = 0.0f;
+	PoseBuffer m_fromPose;
+	PoseBuffer m_targetPose;
+	// ̷    ũ. Ų ޽ø̰  ޽ô    پ   ־ nullptr
+	const BoneMask* m_boneLODMask = nullptr;
+
+	// pose cache. UpdateAll Ӹ ٽ 
+	PoseCacheState m_poseCacheState = PoseCacheState::None;
+	float m_poseCacheSampleTime = 0.0f;
+	const SkeletalMesh* m_poseCacheOwner = nullptr;
+
+	// baked animation. ⺻ Ŭ  ð ϰ ̴ ȷƮ ؽó 
+	bool m_useBakedAnimation = false;
+	BakedAnimationBuffer m_bakedAnimationCB{};
 
 public:
 	SkeletalMesh(const std::wstring& filePath, const std::wstring& psFilePath = L"BlinnPhongPS.hlsl");
@@ -66,7 +125,47 @@ public:
 
 public:
 	void Update(float deltaTime);
-	void PlayAnimation(size_t index);
-	void Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext);
-	void DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext);
+	// νϽ Update JobSystem  .
+	// usePoseCache ̷, Ŭ, ȭ  ð, ִϸ̼ LOD  νϽ   ϰ ȷƮ  .
+	// Owner LOD  ֱ   ũ .
+	// ȯ ٸ νϽ ȷƮ  νϽ 
+	static std::uint32_t UpdateAll(std::vector<SkeletalMesh>& meshes, float deltaTime, bool usePoseCache = true);
+	//  νϽ  Ű  ȷƮ  ϳ   Map ø. ø , ׸ڿ  н  Ӵ  .
+	// Sharer Owner  Ű ũ  νϽ   . Map ϸ   ũ 尡 ƴ νϽ ׸ 
+	static void UploadSkinningPalettes(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext, std::vector<SkeletalMesh>& meshes);
+	// crossfadeDuration 0 ũ  Ŭ  ð  Ѿ
+	// Ų ޽ø .  ְ ⺻ Ŭ  ̸ ũν̵, ̾, additive .
+	// ȯ ũ 尡  
+	bool SetUseBakedAnimation(bool useBakedAnimation);
+	void SetAnimationLOD(AnimationLOD lod);
+	AnimationLOD GetAnimationLOD() const;
+	void PlayAnimation(size_t index, float crossfadeDuration = 0.0f);
+	// rootBoneName Ʒ  weight ŭ index Ŭ 
+	void SetLayerAnimation(size_t index, const std::wstring& rootBoneName, float weight);
+	void StopLayerAnimation();
+	// index Ŭ ù Ӱ ̸ weight ŭ 
+	void SetAdditiveAnimation(size_t index, float weight);
+	void StopAdditiveAnimation();
+	//       AABB ä. Update ڿ ȣ
+	void CalculateWorldBounds(std::vector<DirectX::BoundingBox>& outSectionBounds) const;
+	// sectionIndices: ø   ȣ
+	void Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext,
+		const std::uint32_t* sectionIndices, std::uint32_t sectionCount);
+	void DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext,
+		const std::uint32_t* sectionIndices, std::uint32_t sectionCount);
+
+private:
+	// ̹  ׸ ȷƮ. Sharer Owner 
+	const BoneMatrixArray& GetSkeletonPose() const;
+	bool IsBakedAnimationActive() const;
+	// ũ  ȷƮ ؽó  , ƴϸ ̹  ø Ű ȷƮ  ̴ 
+	void BindBonePose(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext);
+	// ⺻ Ŭ ϳ  ̸  ð ϰ ĳ Ű  ȭ ð ȣ . ƴϸ false
+	bool PreparePoseCache(float deltaTime, std::uint32_t& outTimeStep);
+	// LOD  ӿ ȣ. Owner ĳ ð ⺻ Ŭ øϰ, ƴϸ и ðŭ EvaluatePose
+	void EvaluateScheduledPose(const BoneMask* boneMask, PoseBuffer& out);
+	//   Ŭ deltaTime ŭ ϰ  out 
+	void EvaluatePose(float deltaTime, const BoneMask* boneMask, PoseBuffer& out);
+	// m_pose    m_skeletonPose ä
+	void UpdateSkeletonPose();
 };
\ No newline at end of file
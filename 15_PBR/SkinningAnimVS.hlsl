@@ -5,10 +5,10 @@ PS_INPUT_SHADOW main(VS_INPUT_SKINNING input)
     PS_INPUT_SHADOW output = (PS_INPUT_SHADOW) 0;
     
     float4x4 offsetPose[4];
-    offsetPose[0] = mul(g_boneOffset[input.blendIndices.x], g_bonePose[input.blendIndices.x]);
-    offsetPose[1] = mul(g_boneOffset[input.blendIndices.y], g_bonePose[input.blendIndices.y]);
-    offsetPose[2] = mul(g_boneOffset[input.blendIndices.z], g_bonePose[input.blendIndices.z]);
-    offsetPose[3] = mul(g_boneOffset[input.blendIndices.w], g_bonePose[input.blendIndices.w]);
+    offsetPose[0] = g_skinningPalette[g_paletteOffset + input.blendIndices.x];
+    offsetPose[1] = g_skinningPalette[g_paletteOffset + input.blendIndices.y];
+    offsetPose[2] = g_skinningPalette[g_paletteOffset + input.blendIndices.z];
+    offsetPose[3] = g_skinningPalette[g_paletteOffset + input.blendIndices.w];
     
     float4x4 weightedOffsetPose;
     weightedOffsetPose = mul(input.blendWeights.x, offsetPose[0]);
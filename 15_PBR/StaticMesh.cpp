@@ -102,7 +102,31 @@ void StaticMesh::SetPixelShader(const std::wstring& filePath)
 	m_finalPassPixelShader = D3DResourceManager::Get().GetOrCreatePixelShader(filePath);
 }
 
-void StaticMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext) const
+const std::shared_ptr<StaticMeshData>& StaticMesh::GetStaticMeshData() const
+{
+	return m_staticMeshData;
+}
+
+const DirectX::SimpleMath::Matrix& StaticMesh::GetWorld() const
+{
+	return m_worldTransformCB.world;
+}
+
+void StaticMesh::CalculateWorldBounds(std::vector<DirectX::BoundingBox>& outSectionBounds) const
+{
+	const auto& meshSections = m_staticMeshData->GetMeshSections();
+	const DirectX::XMMATRIX world = DirectX::XMMatrixTranspose(m_worldTransformCB.world);
+
+	outSectionBounds.resize(meshSections.size());
+
+	for (size_t i = 0; i < meshSections.size(); ++i)
+	{
+		meshSections[i].bounds.Transform(outSectionBounds[i], world);
+	}
+}
+
+void StaticMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext,
+	const std::uint32_t* sectionIndices, std::uint32_t sectionCount) const
 {
 	static const UINT s_vertexBufferOffset = 0;
 	const UINT s_vertexBufferStride = m_vertexBuffer->GetBufferStride();
@@ -125,8 +149,9 @@ void StaticMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceC
 
 	const auto& meshSections = m_staticMeshData->GetMeshSections();
 
-	for (const auto& meshSection : meshSections)
+	for (std::uint32_t i = 0; i < sectionCount; ++i)
 	{
+		const auto& meshSection = meshSections[sectionIndices[i]];
 		const auto textureSRVs = m_textureSRVs[meshSection.materialIndex].AsRawArray();
 
 		deviceContext->PSSetShaderResources(0, static_cast<UINT>(textureSRVs.size()), textureSRVs.data());
@@ -135,7 +160,8 @@ void StaticMesh::Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceC
 	}
 }
 
-void StaticMesh::DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext) const
+void StaticMesh::DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext,
+	const std::uint32_t* sectionIndices, std::uint32_t sectionCount) const
 {
 	static const UINT s_vertexBufferOffset = 0;
 	const UINT s_vertexBufferStride = m_vertexBuffer->GetBufferStride();
@@ -154,8 +180,9 @@ void StaticMesh::DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>
 
 	const auto& meshSections = m_staticMeshData->GetMeshSections();
 
-	for (const auto& meshSection : meshSections)
+	for (std::uint32_t i = 0; i < sectionCount; ++i)
 	{
+		const auto& meshSection = meshSections[sectionIndices[i]];
 		auto textureSRV = m_textureSRVs[meshSection.materialIndex].opacityTextureSRV;
 
 		deviceContext->PSSetShaderResources(0, 1, textureSRV->GetShaderResourceView().GetAddressOf());
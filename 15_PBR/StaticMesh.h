@@ -3,6 +3,9 @@
 #include <memory>
 #include <d3d11.h>
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <DirectXCollision.h>
 #include <wrl/client.h>
 
 #include "../Common/ShaderConstant.h"
@@ -52,6 +55,16 @@ public:
 	void SetWorld(const DirectX::SimpleMath::Matrix& world);
 	void SetPixelShader(const std::wstring& filePath);
 
-	void Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext) const;
-	void DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext) const;
+	const std::shared_ptr<StaticMeshData>& GetStaticMeshData() const;
+	// SetWorld  ״ (̴ Transpose  )
+	const DirectX::SimpleMath::Matrix& GetWorld() const;
+
+	//    AABB ä (VisibilityCuller::AddMesh Է)
+	void CalculateWorldBounds(std::vector<DirectX::BoundingBox>& outSectionBounds) const;
+
+	// sectionIndices: ø   ȣ
+	void Draw(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext,
+		const std::uint32_t* sectionIndices, std::uint32_t sectionCount) const;
+	void DrawShadowMap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext,
+		const std::uint32_t* sectionIndices, std::uint32_t sectionCount) const;
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <assimp/scene.h>
 #include <assimp/anim.h>
 #include <cassert>
+#include <cmath>
+#include <algorithm>
 
 #include "../Common/Helper.h"
 
@@ -24,101 +26,336 @@ void Animation::SetupBoneAnimation(std::vector<Bone>& out) const
 	}
 }
 
-void BoneAnimation::Evaluate(float time, LastKeyIndex& inOutLastKeyIndex, Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const
+namespace
 {
-	size_t positionKeyIndex = inOutLastKeyIndex.position;
-	size_t rotationKeyIndex = inOutLastKeyIndex.rotation;
-	size_t scaleKeyIndex = inOutLastKeyIndex.scale;
+	using DirectX::XMVECTOR;
+	using DirectX::FXMVECTOR;
+
+	constexpr float QuantizedVector3Max = 65535.0f;
+	// smallest-three   [-1/2, 1/2] 
+	constexpr float QuaternionComponentRange = 0.70710678f;
+	constexpr float QuantizedQuaternionMax = 32767.0f;
+
+	PackedVector3 PackVector3(const DirectX::SimpleMath::Vector3& value, const QuantizedVector3Track& track)
+	{
+		auto quantize = [](float v, float min, float scale)
+			{
+				const float q = scale > 0.0f ? (v - min) / scale : 0.0f;
+				return static_cast<std::uint16_t>(std::clamp(q + 0.5f, 0.0f, QuantizedVector3Max));
+			};
+
+		return PackedVector3{
+			quantize(value.x, track.min.x, track.scale.x),
+			quantize(value.y, track.min.y, track.scale.y),
+			quantize(value.z, track.min.z, track.scale.z) };
+	}
 
-	if (positionKeys[positionKeyIndex].time >= time)
+	XMVECTOR XM_CALLCONV UnpackVector3(const PackedVector3& packed, FXMVECTOR min, FXMVECTOR scale)
 	{
-		positionKeyIndex = 0;
+		const XMVECTOR q = DirectX::XMVectorSet(packed.x, packed.y, packed.z, 0.0f);
+
+		return DirectX::XMVectorMultiplyAdd(q, scale, min);
 	}
 
-	while (true)
+	PackedQuaternion PackQuaternion(const DirectX::SimpleMath::Quaternion& rotation)
 	{
-		size_t nextIndex = positionKeyIndex + 1;
-		if (nextIndex >= positionKeys.size())
+		float components[4]{ rotation.x, rotation.y, rotation.z, rotation.w };
+
+		std::uint32_t largestIndex = 0;
+		for (std::uint32_t i = 1; i < 4; ++i)
 		{
-			break;
+			if (std::abs(components[i]) > std::abs(components[largestIndex]))
+			{
+				largestIndex = i;
+			}
 		}
 
-		if (positionKeys[nextIndex].time > time)
+		// q -q  ȸ̹Ƿ   ׻  ǵ 
+		const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+		std::uint64_t bits = static_cast<std::uint64_t>(largestIndex) << 45;
+		std::uint32_t shift = 0;
+		for (std::uint32_t i = 0; i < 4; ++i)
 		{
-			outPosition = DirectX::SimpleMath::Vector3::Lerp(
-				positionKeys[positionKeyIndex].value,
-				positionKeys[nextIndex].value,
-				(time - positionKeys[positionKeyIndex].time) / (positionKeys[nextIndex].time - positionKeys[positionKeyIndex].time));
-			inOutLastKeyIndex.position = positionKeyIndex;
+			if (i == largestIndex)
+			{
+				continue;
+			}
 
-			break;
+			const float normalized = (components[i] * sign / QuaternionComponentRange) * 0.5f + 0.5f;
+			const float q = std::clamp(normalized * QuantizedQuaternionMax + 0.5f, 0.0f, QuantizedQuaternionMax);
+			bits |= static_cast<std::uint64_t>(q) << shift;
+			shift += 15;
 		}
 
-		positionKeyIndex = nextIndex;
+		return PackedQuaternion{ {
+			static_cast<std::uint16_t>(bits),
+			static_cast<std::uint16_t>(bits >> 16),
+			static_cast<std::uint16_t>(bits >> 32) } };
 	}
 
-	if (rotationKeys[rotationKeyIndex].time >= time)
+	XMVECTOR XM_CALLCONV UnpackQuaternion(const PackedQuaternion& packed)
 	{
-		rotationKeyIndex = 0;
+		const std::uint64_t bits =
+			static_cast<std::uint64_t>(packed.data[0]) |
+			static_cast<std::uint64_t>(packed.data[1]) << 16 |
+			static_cast<std::uint64_t>(packed.data[2]) << 32;
+
+		const XMVECTOR q = DirectX::XMVectorSet(
+			static_cast<float>(bits & 0x7FFF),
+			static_cast<float>((bits >> 15) & 0x7FFF),
+			static_cast<float>((bits >> 30) & 0x7FFF),
+			0.0f);
+
+		// q / max * 2 * range - range
+		const XMVECTOR abc = DirectX::XMVectorMultiplyAdd(q,
+			DirectX::XMVectorReplicate(2.0f * QuaternionComponentRange / QuantizedQuaternionMax),
+			DirectX::XMVectorReplicate(-QuaternionComponentRange));
+
+		const XMVECTOR d = DirectX::XMVectorSqrt(DirectX::XMVectorMax(DirectX::g_XMZero,
+			DirectX::XMVectorSubtract(DirectX::g_XMOne, DirectX::XMVector3Dot(abc, abc))));
+
+		switch (bits >> 45)
+		{
+		case 0:
+			return DirectX::XMVectorPermute<4, 0, 1, 2>(abc, d);
+		case 1:
+			return DirectX::XMVectorPermute<0, 4, 1, 2>(abc, d);
+		case 2:
+			return DirectX::XMVectorPermute<0, 1, 4, 2>(abc, d);
+		default:
+			return DirectX::XMVectorPermute<0, 1, 2, 4>(abc, d);
+		}
 	}
 
-	while (true)
+	template<typename T, typename Decode, typename Interpolate>
+	XMVECTOR SampleTrack(const KeyTrack<T>& track, float time, size_t& inOutCursor, Decode decode, Interpolate interpolate)
 	{
-		size_t nextIndex = rotationKeyIndex + 1;
-		if (nextIndex >= rotationKeys.size())
+		const size_t keyIndex = track.FindKey(time, inOutCursor);
+		const size_t nextIndex = keyIndex + 1;
+
+		if (nextIndex >= track.times.size() || time <= track.times[keyIndex])
 		{
-			break;
+			return decode(track.values[keyIndex]);
 		}
 
-		if (rotationKeys[nextIndex].time > time)
-		{
-			outRotation = DirectX::SimpleMath::Quaternion::Slerp(
-				rotationKeys[rotationKeyIndex].value,
-				rotationKeys[nextIndex].value,
-				(time - (rotationKeys[rotationKeyIndex].time)) / (rotationKeys[nextIndex].time - rotationKeys[rotationKeyIndex].time)
-			);
+		const float t = (time - track.times[keyIndex]) / (track.times[nextIndex] - track.times[keyIndex]);
+
+		return interpolate(decode(track.values[keyIndex]), decode(track.values[nextIndex]), t);
+	}
 
-			inOutLastKeyIndex.rotation = rotationKeyIndex;
+	XMVECTOR XM_CALLCONV LerpVector3(FXMVECTOR a, FXMVECTOR b, float t)
+	{
+		return DirectX::XMVectorLerp(a, b, t);
+	}
 
-			break;
-		}
+	XMVECTOR XM_CALLCONV SlerpQuaternion(FXMVECTOR a, FXMVECTOR b, float t)
+	{
+		return DirectX::XMQuaternionSlerp(a, b, t);
+	}
 
-		rotationKeyIndex = nextIndex;
+	float Vector3Error(const DirectX::SimpleMath::Vector3& a, const DirectX::SimpleMath::Vector3& b)
+	{
+		return DirectX::SimpleMath::Vector3::Distance(a, b);
+	}
+
+	//  ȸ   ()
+	float QuaternionError(const DirectX::SimpleMath::Quaternion& a, const DirectX::SimpleMath::Quaternion& b)
+	{
+		const float cosHalfAngle = std::min<float>(std::abs(a.Dot(b)), 1.0f);
+
+		return 2.0f * std::acos(cosHalfAngle);
 	}
 
-	if (scaleKeys[scaleKeyIndex].time >= time)
+	// տ  Ű  Ű      Ű   ȿ  .
+	//  Ű ù Ű  ̸ Ű ϳ 
+	template<typename T, typename Interpolate, typename Error>
+	std::vector<size_t> ReduceKeys(const KeyTrack<T>& track, float tolerance, Interpolate interpolate, Error error)
 	{
-		scaleKeyIndex = 0;
+		const size_t keyCount = track.times.size();
+		if (keyCount == 0)
+		{
+			return {};
+		}
+
+		bool isConstant = true;
+		for (size_t i = 1; i < keyCount && isConstant; ++i)
+		{
+			isConstant = error(track.values[0], track.values[i]) <= tolerance;
+		}
+
+		if (isConstant)
+		{
+			return { 0 };
+		}
+
+		std::vector<size_t> keptKeys{ 0 };
+
+		for (size_t i = 1; i + 1 < keyCount; ++i)
+		{
+			const size_t prev = keptKeys.back();
+			const size_t next = i + 1;
+			const float span = track.times[next] - track.times[prev];
+
+			bool canRemove = true;
+			for (size_t j = prev + 1; j < next && canRemove; ++j)
+			{
+				const float t = span > 0.0f ? (track.times[j] - track.times[prev]) / span : 0.0f;
+				canRemove = error(interpolate(track.values[prev], track.values[next], t), track.values[j]) <= tolerance;
+			}
+
+			if (!canRemove)
+			{
+				keptKeys.push_back(i);
+			}
+		}
+
+		keptKeys.push_back(keyCount - 1);
+
+		return keptKeys;
 	}
 
-	while (true)
+	QuantizedVector3Track CompressVector3Track(const KeyTrack<DirectX::SimpleMath::Vector3>& track, float tolerance)
 	{
-		size_t nextIndex = scaleKeyIndex + 1;
-		if (nextIndex >= scaleKeys.size())
+		using DirectX::SimpleMath::Vector3;
+
+		const std::vector<size_t> keptKeys = ReduceKeys(track, tolerance,
+			[](const Vector3& a, const Vector3& b, float t) { return Vector3::Lerp(a, b, t); }, Vector3Error);
+
+		QuantizedVector3Track compressed;
+		if (keptKeys.empty())
+		{
+			return compressed;
+		}
+
+		Vector3 max = track.values[keptKeys[0]];
+		compressed.min = max;
+		for (size_t keyIndex : keptKeys)
 		{
-			break;
+			compressed.min = Vector3::Min(compressed.min, track.values[keyIndex]);
+			max = Vector3::Max(max, track.values[keyIndex]);
 		}
+		compressed.scale = (max - compressed.min) / QuantizedVector3Max;
 
-		if (scaleKeys[nextIndex].time > time)
+		compressed.keys.Reserve(keptKeys.size());
+		for (size_t keyIndex : keptKeys)
 		{
-			outScale = DirectX::SimpleMath::Vector3::Lerp(
-				scaleKeys[scaleKeyIndex].value,
-				scaleKeys[nextIndex].value,
-				(time - (scaleKeys[scaleKeyIndex].time)) / (scaleKeys[nextIndex].time - scaleKeys[scaleKeyIndex].time)
-			);
+			compressed.keys.AddKey(track.times[keyIndex], PackVector3(track.values[keyIndex], compressed));
+		}
+
+		return compressed;
+	}
+
+	KeyTrack<PackedQuaternion> CompressQuaternionTrack(const KeyTrack<DirectX::SimpleMath::Quaternion>& track, float tolerance)
+	{
+		using DirectX::SimpleMath::Quaternion;
+
+		const std::vector<size_t> keptKeys = ReduceKeys(track, tolerance,
+			[](const Quaternion& a, const Quaternion& b, float t) { return Quaternion::Slerp(a, b, t); }, QuaternionError);
 
-			inOutLastKeyIndex.scale = scaleKeyIndex;
+		KeyTrack<PackedQuaternion> compressed;
 
-			break;
+		compressed.Reserve(keptKeys.size());
+		for (size_t keyIndex : keptKeys)
+		{
+			Quaternion rotation = track.values[keyIndex];
+			rotation.Normalize();
+			compressed.AddKey(track.times[keyIndex], PackQuaternion(rotation));
 		}
 
-		scaleKeyIndex = nextIndex;
+		return compressed;
+	}
+}
+
+void BoneAnimation::Evaluate(float time, LastKeyIndex& inOutLastKeyIndex, Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const
+{
+	if (isCompressed)
+	{
+		const XMVECTOR positionMin = DirectX::XMLoadFloat3(&compressedPositionTrack.min);
+		const XMVECTOR positionScale = DirectX::XMLoadFloat3(&compressedPositionTrack.scale);
+		const XMVECTOR scaleMin = DirectX::XMLoadFloat3(&compressedScaleTrack.min);
+		const XMVECTOR scaleScale = DirectX::XMLoadFloat3(&compressedScaleTrack.scale);
+
+		outPosition = SampleTrack(compressedPositionTrack.keys, time, inOutLastKeyIndex.position,
+			[&](const PackedVector3& packed) { return UnpackVector3(packed, positionMin, positionScale); }, LerpVector3);
+
+		outRotation = SampleTrack(compressedRotationTrack, time, inOutLastKeyIndex.rotation,
+			UnpackQuaternion, SlerpQuaternion);
+
+		outScale = SampleTrack(compressedScaleTrack.keys, time, inOutLastKeyIndex.scale,
+			[&](const PackedVector3& packed) { return UnpackVector3(packed, scaleMin, scaleScale); }, LerpVector3);
+
+		return;
+	}
+
+	outPosition = SampleTrack(positionTrack, time, inOutLastKeyIndex.position,
+		[](const Vector3& value) { return DirectX::XMLoadFloat3(&value); }, LerpVector3);
+
+	outRotation = SampleTrack(rotationTrack, time, inOutLastKeyIndex.rotation,
+		[](const Quaternion& value) { return DirectX::XMLoadFloat4(&value); }, SlerpQuaternion);
+
+	outScale = SampleTrack(scaleTrack, time, inOutLastKeyIndex.scale,
+		[](const Vector3& value) { return DirectX::XMLoadFloat3(&value); }, LerpVector3);
+}
+
+void BoneAnimation::Compress(const AnimationCompressionSettings& settings, AnimationCompressionReport& inOutReport)
+{
+	const size_t rawKeyCount = positionTrack.times.size() + rotationTrack.times.size() + scaleTrack.times.size();
+
+	inOutReport.rawKeyCount += rawKeyCount;
+	inOutReport.rawBytes +=
+		positionTrack.times.size() * (sizeof(float) + sizeof(Vector3)) +
+		rotationTrack.times.size() * (sizeof(float) + sizeof(Quaternion)) +
+		scaleTrack.times.size() * (sizeof(float) + sizeof(Vector3));
+
+	compressedPositionTrack = CompressVector3Track(positionTrack, settings.positionTolerance);
+	compressedRotationTrack = CompressQuaternionTrack(rotationTrack, settings.rotationTolerance);
+	compressedScaleTrack = CompressVector3Track(scaleTrack, settings.scaleTolerance);
+	isCompressed = true;
+
+	inOutReport.compressedKeyCount +=
+		compressedPositionTrack.keys.times.size() + compressedRotationTrack.times.size() + compressedScaleTrack.keys.times.size();
+	inOutReport.compressedBytes +=
+		compressedPositionTrack.keys.times.size() * (sizeof(float) + sizeof(PackedVector3)) +
+		compressedRotationTrack.times.size() * (sizeof(float) + sizeof(PackedQuaternion)) +
+		compressedScaleTrack.keys.times.size() * (sizeof(float) + sizeof(PackedVector3)) +
+		sizeof(Vector3) * 4;
+
+	//  Ű ð ົ Ǯ  
+	LastKeyIndex cursor{};
+	Vector3 position, scale;
+	Quaternion rotation;
+
+	for (size_t i = 0; i < positionTrack.times.size(); ++i)
+	{
+		Evaluate(positionTrack.times[i], cursor, position, rotation, scale);
+		inOutReport.maxPositionError = std::max<float>(inOutReport.maxPositionError, Vector3Error(position, positionTrack.values[i]));
+	}
+
+	cursor = LastKeyIndex{};
+	for (size_t i = 0; i < rotationTrack.times.size(); ++i)
+	{
+		Evaluate(rotationTrack.times[i], cursor, position, rotation, scale);
+		inOutReport.maxRotationError = std::max<float>(inOutReport.maxRotationError, QuaternionError(rotation, rotationTrack.values[i]));
+	}
+
+	cursor = LastKeyIndex{};
+	for (size_t i = 0; i < scaleTrack.times.size(); ++i)
+	{
+		Evaluate(scaleTrack.times[i], cursor, position, rotation, scale);
+		inOutReport.maxScaleError = std::max<float>(inOutReport.maxScaleError, Vector3Error(scale, scaleTrack.values[i]));
 	}
+
+	positionTrack = KeyTrack<Vector3>{};
+	rotationTrack = KeyTrack<Quaternion>{};
+	scaleTrack = KeyTrack<Vector3>{};
 }
 
-void AnimationData::Create(const aiScene* scene, const std::shared_ptr<SkeletonData>& skeletonData)
+void AnimationData::Create(const aiScene* scene, const std::shared_ptr<SkeletonData>& skeletonData,
+	const AnimationCompressionSettings& compressionSettings)
 {
 	m_animations.reserve(scene->mNumAnimations);
+	m_compressionReports.resize(scene->mNumAnimations);
 
 	for (unsigned int i = 0; i < scene->mNumAnimations; ++i)
 	{
@@ -135,30 +372,49 @@ void AnimationData::Create(const aiScene* scene, const std::shared_ptr<SkeletonD
 			const aiNodeAnim* anim = aiAnim->mChannels[i];
 			const std::wstring boneName{ ToWideCharStr(anim->mNodeName.C_Str()) };
 
-			animation.boneAnimations[i].boneIndex = skeletonData->GetBoneIndexByBoneName(boneName);
+			BoneAnimation& boneAnimation = animation.boneAnimations[i];
+
+			boneAnimation.boneIndex = skeletonData->GetBoneIndexByBoneName(boneName);
 			animation.animMappingTable[boneName] = i;
 
-			animation.boneAnimations[i].positionKeys.reserve(anim->mNumPositionKeys);
-			animation.boneAnimations[i].rotationKeys.reserve(anim->mNumRotationKeys);
-			animation.boneAnimations[i].scaleKeys.reserve(anim->mNumScalingKeys);
+			boneAnimation.positionTrack.Reserve(anim->mNumPositionKeys);
+			boneAnimation.rotationTrack.Reserve(anim->mNumRotationKeys);
+			boneAnimation.scaleTrack.Reserve(anim->mNumScalingKeys);
 
 			for (unsigned int j = 0; j < anim->mNumPositionKeys; ++j)
 			{
-				animation.boneAnimations[i].positionKeys.emplace_back(static_cast<float>(anim->mPositionKeys[j].mTime / aiAnim->mTicksPerSecond),
-					&anim->mPositionKeys[j].mValue.x);
+				const aiVectorKey& key = anim->mPositionKeys[j];
+				boneAnimation.positionTrack.AddKey(static_cast<float>(key.mTime / aiAnim->mTicksPerSecond),
+					DirectX::SimpleMath::Vector3(key.mValue.x, key.mValue.y, key.mValue.z));
 			}
 
 			for (unsigned int j = 0; j < anim->mNumRotationKeys; ++j)
 			{
-				animation.boneAnimations[i].rotationKeys.emplace_back(static_cast<float>(anim->mRotationKeys[j].mTime / aiAnim->mTicksPerSecond),
-					&anim->mRotationKeys[j].mValue.w);
+				const aiQuatKey& key = anim->mRotationKeys[j];
+				boneAnimation.rotationTrack.AddKey(static_cast<float>(key.mTime / aiAnim->mTicksPerSecond),
+					DirectX::SimpleMath::Quaternion(key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w));
 			}
 
 			for (unsigned int j = 0; j < anim->mNumScalingKeys; ++j)
 			{
-				animation.boneAnimations[i].scaleKeys.emplace_back(static_cast<float>(anim->mScalingKeys[j].mTime / aiAnim->mTicksPerSecond),
-					&anim->mScalingKeys[j].mValue.x);
+				const aiVectorKey& key = anim->mScalingKeys[j];
+				boneAnimation.scaleTrack.AddKey(static_cast<float>(key.mTime / aiAnim->mTicksPerSecond),
+					DirectX::SimpleMath::Vector3(key.mValue.x, key.mValue.y, key.mValue.z));
+			}
+		}
+
+		if (compressionSettings.compress)
+		{
+			AnimationCompressionReport& report = m_compressionReports[i];
+			for (auto& boneAnimation : animation.boneAnimations)
+			{
+				boneAnimation.Compress(compressionSettings, report);
 			}
+
+			Log("Animation \"", aiAnim->mName.C_Str(), "\": keys ", report.rawKeyCount, " -> ", report.compressedKeyCount,
+				", bytes ", report.rawBytes, " -> ", report.compressedBytes,
+				" (", static_cast<float>(report.rawBytes) / std::max<size_t>(report.compressedBytes, 1), "x)",
+				", max error pos ", report.maxPositionError, " rot ", report.maxRotationError, " scale ", report.maxScaleError);
 		}
 
 		m_animations.push_back(std::move(animation));
@@ -168,4 +424,9 @@ void AnimationData::Create(const aiScene* scene, const std::shared_ptr<SkeletonD
 const std::vector<Animation>& AnimationData::GetAnimations() const
 {
 	return m_animations;
+}
+
+const std::vector<AnimationCompressionReport>& AnimationData::GetCompressionReports() const
+{
+	return m_compressionReports;
 }
\ No newline at end of file
@@ -1,48 +1,116 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <directxtk/SimpleMath.h>
 #include <memory>
+#include <cstdint>
 
 #include "SkeletonData.h"
 #include "AssetData.h"
 
-struct PositionKey
+// ð   Ƶ Ű Ʈ. Ű ã  ð 迭 
+template<typename T>
+struct KeyTrack
 {
-	float time;
-	DirectX::SimpleMath::Vector3 value;
+	std::vector<float> times;
+	std::vector<T> values;
 
-	PositionKey(float time, const float* f)
-		: time{ time }, value{ f }
-	{
+	void Reserve(size_t count);
+	void AddKey(float time, const T& value);
 
-	}
+	// times[i] <= time < times[i + 1] i. ó/ Ű ̸  Ű 
+	// inOutCursor   Ű  , ƴϸ  Ž ( ǰܵ O(log k))
+	size_t FindKey(float time, size_t& inOutCursor) const;
 };
 
-struct RotationKey
+template<typename T>
+void KeyTrack<T>::Reserve(size_t count)
 {
-	float time;
-	DirectX::SimpleMath::Quaternion value;
+	times.reserve(count);
+	values.reserve(count);
+}
 
-	RotationKey(float time, const float* f)
-		: time{ time }, value{ f[1], f[2], f[3], f[0] }
-	{
+template<typename T>
+void KeyTrack<T>::AddKey(float time, const T& value)
+{
+	times.push_back(time);
+	values.push_back(value);
+}
+
+template<typename T>
+size_t KeyTrack<T>::FindKey(float time, size_t& inOutCursor) const
+{
+	const size_t keyCount = times.size();
+	size_t cursor = inOutCursor < keyCount ? inOutCursor : 0;
 
+	//  ߿  ӿ Ű ϳ ̳ θ  찡 κ
+	if (times[cursor] <= time)
+	{
+		if (cursor + 1 >= keyCount || time < times[cursor + 1])
+		{
+			return cursor;
+		}
+
+		if (cursor + 2 >= keyCount || time < times[cursor + 2])
+		{
+			inOutCursor = cursor + 1;
+			return inOutCursor;
+		}
 	}
+
+	//  ó ưų  ġ ̵ 
+	const auto upper = std::upper_bound(times.begin(), times.end(), time);
+	cursor = upper == times.begin() ? 0 : static_cast<size_t>(upper - times.begin()) - 1;
+
+	inOutCursor = cursor;
+	return cursor;
+}
+
+// Ʈ  ȭ Vector3 (ึ 16Ʈ)
+struct PackedVector3
+{
+	std::uint16_t x;
+	std::uint16_t y;
+	std::uint16_t z;
 };
 
-struct ScaleKey
+// smallest-three 48Ʈ ʹϾ.   ū   ( ̷ )
+//    15Ʈ +   ε 2Ʈ
+struct PackedQuaternion
 {
-	float time;
-	DirectX::SimpleMath::Vector3 value;
+	std::uint16_t data[3];
+};
 
-	ScaleKey(float time, const float* f)
-		: time{ time }, value{ f }
-	{
+//  = min + q * scale
+struct QuantizedVector3Track
+{
+	KeyTrack<PackedVector3> keys;
+	DirectX::SimpleMath::Vector3 min;
+	DirectX::SimpleMath::Vector3 scale;
+};
 
-	}
+struct AnimationCompressionSettings
+{
+	bool compress = true;
+	//  ٽ   ִ Ű   ϴ . ġ,   , ȸ 
+	float positionTolerance = 0.01f;
+	float rotationTolerance = 0.001f;
+	float scaleTolerance = 0.001f;
+};
+
+// Ŭ ϳ  .   Ű ð  ົ  ִ
+struct AnimationCompressionReport
+{
+	size_t rawKeyCount = 0;
+	size_t compressedKeyCount = 0;
+	size_t rawBytes = 0;
+	size_t compressedBytes = 0;
+	float maxPositionError = 0.0f;
+	float maxRotationError = 0.0f;
+	float maxScaleError = 0.0f;
 };
 
 struct LastKeyIndex;
@@ -52,12 +120,21 @@ struct BoneAnimation
 	using Vector3 = DirectX::SimpleMath::Vector3;
 	using Quaternion = DirectX::SimpleMath::Quaternion;
 
-	std::vector<PositionKey> positionKeys;
-	std::vector<RotationKey> rotationKeys;
-	std::vector<ScaleKey> scaleKeys;
+	//  Ʈ. Compress Ŀ  
+	KeyTrack<Vector3> positionTrack;
+	KeyTrack<Quaternion> rotationTrack;
+	KeyTrack<Vector3> scaleTrack;
+
+	QuantizedVector3Track compressedPositionTrack;
+	KeyTrack<PackedQuaternion> compressedRotationTrack;
+	QuantizedVector3Track compressedScaleTrack;
+	bool isCompressed = false;
+
 	unsigned int boneIndex;
 
 	void Evaluate(float time, LastKeyIndex& inOutLastKeyIndex, Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const;
+	//  Ʈ  Ʈ ٲٰ  inOutReport 
+	void Compress(const AnimationCompressionSettings& settings, AnimationCompressionReport& inOutReport);
 };
 
 struct Animation
@@ -81,10 +158,14 @@ class AnimationData :
 {
 private:
 	std::vector<Animation> m_animations;
+	// m_animations  
+	std::vector<AnimationCompressionReport> m_compressionReports;
 
 public:
-	void Create(const aiScene* scene, const std::shared_ptr<SkeletonData>& skeletonData);
+	void Create(const aiScene* scene, const std::shared_ptr<SkeletonData>& skeletonData,
+		const AnimationCompressionSettings& compressionSettings = AnimationCompressionSettings{});
 
 public:
 	const std::vector<Animation>& GetAnimations() const;
+	const std::vector<AnimationCompressionReport>& GetCompressionReports() const;
 };
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "AnimationPose.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SkeletonData.h"
+#include "AnimationData.h"
+
+namespace
+{
+	using DirectX::XMVECTOR;
+	using DirectX::FXMVECTOR;
+
+	// ª  ȣ lerp  ȭ.  ġ   slerp ̰  
+	XMVECTOR XM_CALLCONV NLerpQuaternion(FXMVECTOR from, FXMVECTOR to, float t)
+	{
+		const XMVECTOR dot = DirectX::XMQuaternionDot(from, to);
+		const XMVECTOR sign = DirectX::XMVectorSelect(DirectX::g_XMOne, DirectX::g_XMNegativeOne, DirectX::XMVectorLess(dot, DirectX::XMVectorZero()));
+
+		return DirectX::XMQuaternionNormalize(DirectX::XMVectorLerp(from, DirectX::XMVectorMultiply(to, sign), t));
+	}
+
+	void BlendBone(const PoseBuffer& from, const PoseBuffer& to, size_t i, float weight, PoseBuffer& out)
+	{
+		using namespace DirectX;
+
+		XMStoreFloat3(&out.translations[i], XMVectorLerp(XMLoadFloat3(&from.translations[i]), XMLoadFloat3(&to.translations[i]), weight));
+		XMStoreFloat4(&out.rotations[i], NLerpQuaternion(XMLoadFloat4(&from.rotations[i]), XMLoadFloat4(&to.rotations[i]), weight));
+		XMStoreFloat3(&out.scales[i], XMVectorLerp(XMLoadFloat3(&from.scales[i]), XMLoadFloat3(&to.scales[i]), weight));
+	}
+}
+
+void PoseBuffer::Resize(size_t boneCount)
+{
+	translations.resize(boneCount, DirectX::SimpleMath::Vector3::Zero);
+	rotations.resize(boneCount, DirectX::SimpleMath::Quaternion::Identity);
+	scales.resize(boneCount, DirectX::SimpleMath::Vector3::One);
+}
+
+size_t PoseBuffer::GetBoneCount() const
+{
+	return translations.size();
+}
+
+void AnimationPlayback::Start(size_t animationIndex)
+{
+	index = animationIndex;
+	time = 0.0f;
+	cursors.clear();
+}
+
+void AnimationPlayback::Stop()
+{
+	index = NONE;
+}
+
+bool AnimationPlayback::IsPlaying() const
+{
+	return index != NONE;
+}
+
+void AnimationPlayback::Advance(const Animation& animation, float deltaTime)
+{
+	time += deltaTime;
+
+	if (animation.duration > 0.0f)
+	{
+		time = std::fmod(time, animation.duration);
+	}
+}
+
+void AnimationPose::SetupBindPose(const std::vector<Bone>& skeleton, PoseBuffer& out)
+{
+	out.Resize(skeleton.size());
+
+	for (const auto& bone : skeleton)
+	{
+		DirectX::XMVECTOR scale, rotation, translation;
+		DirectX::XMMatrixDecompose(&scale, &rotation, &translation, DirectX::XMLoadFloat4x4(&bone.local));
+
+		DirectX::XMStoreFloat3(&out.translations[bone.index], translation);
+		DirectX::XMStoreFloat4(&out.rotations[bone.index], rotation);
+		DirectX::XMStoreFloat3(&out.scales[bone.index], scale);
+	}
+}
+
+void AnimationPose::Sample(const Animation& animation, float time, const PoseBuffer& bindPose,
+	std::vector<LastKeyIndex>& inOutCursors, PoseBuffer& out, const BoneMask* boneMask)
+{
+	out.translations.assign(bindPose.translations.begin(), bindPose.translations.end());
+	out.rotations.assign(bindPose.rotations.begin(), bindPose.rotations.end());
+	out.scales.assign(bindPose.scales.begin(), bindPose.scales.end());
+
+	inOutCursors.resize(animation.boneAnimations.size());
+
+	for (size_t i = 0; i < animation.boneAnimations.size(); ++i)
+	{
+		const BoneAnimation& boneAnimation = animation.boneAnimations[i];
+
+		if (boneAnimation.boneIndex >= out.GetBoneCount())
+		{
+			continue;
+		}
+
+		if (boneMask != nullptr && boneAnimation.boneIndex < boneMask->weights.size() && boneMask->weights[boneAnimation.boneIndex] == 0.0f)
+		{
+			continue;
+		}
+
+		boneAnimation.Evaluate(time, inOutCursors[i],
+			out.translations[boneAnimation.boneIndex], out.rotations[boneAnimation.boneIndex], out.scales[boneAnimation.boneIndex]);
+	}
+}
+
+void AnimationPose::CopyMasked(const PoseBuffer& source, const BoneMask& mask, PoseBuffer& out)
+{
+	const size_t boneCount = std::min({ source.GetBoneCount(), out.GetBoneCount(), mask.weights.size() });
+
+	for (size_t i = 0; i < boneCount; ++i)
+	{
+		if (mask.weights[i] != 0.0f)
+		{
+			continue;
+		}
+
+		out.translations[i] = source.translations[i];
+		out.rotations[i] = source.rotations[i];
+		out.scales[i] = source.scales[i];
+	}
+}
+
+void AnimationPose::Blend(const PoseBuffer& from, const PoseBuffer& to, float weight, PoseBuffer& out)
+{
+	const size_t boneCount = std::min(from.GetBoneCount(), to.GetBoneCount());
+	out.Resize(boneCount);
+
+	for (size_t i = 0; i < boneCount; ++i)
+	{
+		BlendBone(from, to, i, weight, out);
+	}
+}
+
+void AnimationPose::BlendMasked(const PoseBuffer& base, const PoseBuffer& layer, const BoneMask& mask, float weight, PoseBuffer& out)
+{
+	const size_t boneCount = std::min(base.GetBoneCount(), layer.GetBoneCount());
+	out.Resize(boneCount);
+
+	for (size_t i = 0; i < boneCount; ++i)
+	{
+		const float boneWeight = i < mask.weights.size() ? weight * mask.weights[i] : 0.0f;
+
+		BlendBone(base, layer, i, boneWeight, out);
+	}
+}
+
+void AnimationPose::AddAdditive(const PoseBuffer& base, const PoseBuffer& additive, const PoseBuffer& reference, float weight, PoseBuffer& out)
+{
+	using namespace DirectX;
+
+	const size_t boneCount = std::min({ base.GetBoneCount(), additive.GetBoneCount(), reference.GetBoneCount() });
+	out.Resize(boneCount);
+
+	const XMVECTOR weightVector = XMVectorReplicate(weight);
+
+	for (size_t i = 0; i < boneCount; ++i)
+	{
+		// XMQuaternionMultiply(reference, delta) == additive  delta  base ڿ 
+		const XMVECTOR referenceRotation = XMLoadFloat4(&reference.rotations[i]);
+		const XMVECTOR deltaRotation = XMQuaternionMultiply(XMQuaternionInverse(referenceRotation), XMLoadFloat4(&additive.rotations[i]));
+		const XMVECTOR weightedDelta = NLerpQuaternion(XMQuaternionIdentity(), deltaRotation, weight);
+		XMStoreFloat4(&out.rotations[i], XMQuaternionNormalize(XMQuaternionMultiply(XMLoadFloat4(&base.rotations[i]), weightedDelta)));
+
+		const XMVECTOR deltaTranslation = XMVectorSubtract(XMLoadFloat3(&additive.translations[i]), XMLoadFloat3(&reference.translations[i]));
+		XMStoreFloat3(&out.translations[i], XMVectorMultiplyAdd(deltaTranslation, weightVector, XMLoadFloat3(&base.translations[i])));
+
+		const XMVECTOR deltaScale = XMVectorSubtract(XMLoadFloat3(&additive.scales[i]), XMLoadFloat3(&reference.scales[i]));
+		XMStoreFloat3(&out.scales[i], XMVectorMultiplyAdd(deltaScale, weightVector, XMLoadFloat3(&base.scales[i])));
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <directxtk/SimpleMath.h>
+
+#include "SkeletonData.h"
+
+struct Animation;
+
+//  ȣ    .   ƴ϶ TRS ¿ ϰ      ķ ٲ
+struct PoseBuffer
+{
+	std::vector<DirectX::SimpleMath::Vector3> translations;
+	std::vector<DirectX::SimpleMath::Quaternion> rotations;
+	std::vector<DirectX::SimpleMath::Vector3> scales;
+
+	void Resize(size_t boneCount);
+	size_t GetBoneCount() const;
+};
+
+//   Ŭ ϳ . cursors Ŭ boneAnimations  
+struct AnimationPlayback
+{
+	static constexpr size_t NONE = static_cast<size_t>(-1);
+
+	size_t index = NONE;
+	float time = 0.0f;
+	std::vector<LastKeyIndex> cursors;
+
+	void Start(size_t animationIndex);
+	void Stop();
+	bool IsPlaying() const;
+	// Ŭ ̷ ݺ
+	void Advance(const Animation& animation, float deltaTime);
+};
+
+namespace AnimationPose
+{
+	// νϽ ε (Bone::local) TRS 
+	void SetupBindPose(const std::vector<Bone>& skeleton, PoseBuffer& out);
+
+	// Ŭ Ʈ   boneMask 0  bindPose . inOutCursors Ŭ boneAnimations  
+	void Sample(const Animation& animation, float time, const PoseBuffer& bindPose,
+		std::vector<LastKeyIndex>& inOutCursors, PoseBuffer& out, const BoneMask* boneMask = nullptr);
+	// mask 0  source  ǵ. ø ǳʶ       
+	void CopyMasked(const PoseBuffer& source, const BoneMask& mask, PoseBuffer& out);
+
+	// weight 0̸ from, 1̸ to. out from, to Ƶ 
+	void Blend(const PoseBuffer& from, const PoseBuffer& to, float weight, PoseBuffer& out);
+	//  weight * mask ŭ layer  
+	void BlendMasked(const PoseBuffer& base, const PoseBuffer& layer, const BoneMask& mask, float weight, PoseBuffer& out);
+	// additive - reference ̸ weight ŭ base  
+	void AddAdditive(const PoseBuffer& base, const PoseBuffer& additive, const PoseBuffer& reference, float weight, PoseBuffer& out);
+}
@@ -6,6 +6,7 @@
 #include "SkeletalMeshData.h"
 #include "SkeletonData.h"
 #include "AnimationData.h"
+#include "BakedAnimationData.h"
 
 AssetManager& AssetManager::Get()
 {
@@ -129,3 +130,29 @@ std::shared_ptr<SkeletonData> AssetManager::GetOrCreateSkeletonAsset(const std::
 
 	return fbx->GetSkeletonData();
 }
+
+std::shared_ptr<BakedAnimationData> AssetManager::GetOrCreateBakedAnimationAsset(const std::wstring& filePath, float framesPerSecond)
+{
+	//  ϵ ӷƮ ٸ   ø ð ޶  
+	const std::wstring key = filePath + L"@" + std::to_wstring(framesPerSecond);
+
+	auto find = m_bakedAnimationAssets.find(key);
+	if (find != m_bakedAnimationAssets.end())
+	{
+		if (!find->second.expired())
+		{
+			return find->second.lock();
+		}
+	}
+
+	std::shared_ptr<SkeletonData> skeletonData = GetOrCreateSkeletonAsset(filePath);
+	std::shared_ptr<AnimationData> animationData = GetOrCreateAnimationAsset(filePath);
+	std::shared_ptr<SkeletalMeshData> skeletalMeshData = GetOrCreateSkeletalMeshAsset(filePath);
+
+	std::shared_ptr<BakedAnimationData> bakedAnimationData = std::make_shared<BakedAnimationData>();
+	bakedAnimationData->Create(*skeletonData, *animationData, skeletalMeshData->GetMeshSections(), framesPerSecond);
+
+	m_bakedAnimationAssets[key] = bakedAnimationData;
+
+	return bakedAnimationData;
+}
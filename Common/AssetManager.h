@@ -11,6 +11,7 @@ class MaterialData;
 class SkeletalMeshData;
 class AnimationData;
 class SkeletonData;
+class BakedAnimationData;
 
 class AssetManager
 {
@@ -26,6 +27,8 @@ private:
 	std::unordered_map<std::wstring, std::weak_ptr<SkeletonData>> m_skeletonAssets;
 	std::unordered_map<std::wstring, std::weak_ptr<SkeletalMeshData>> m_skeletalMeshAssets;
 	std::unordered_map<std::wstring, std::weak_ptr<AnimationData>> m_animationAssets;
+	// Ű  ο ӷƮ
+	std::unordered_map<std::wstring, std::weak_ptr<BakedAnimationData>> m_bakedAnimationAssets;
 
 private:
 	AssetManager() = default;
@@ -44,4 +47,6 @@ public:
 	std::shared_ptr<SkeletonData> GetOrCreateSkeletonAsset(const std::wstring& filePath);
 	std::shared_ptr<SkeletalMeshData> GetOrCreateSkeletalMeshAsset(const std::wstring& filePath);
 	std::shared_ptr<AnimationData> GetOrCreateAnimationAsset(const std::wstring& filePath);
+	//   Ŭ  ȷƮ ؽó  . ó   ø  ŭ
+	std::shared_ptr<BakedAnimationData> GetOrCreateBakedAnimationAsset(const std::wstring& filePath, float framesPerSecond = 30.0f);
 };
\ No newline at end of file
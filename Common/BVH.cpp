@@ -0,0 +1,2225 @@
+#include "BVH.h"
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cfloat>
+#include <cmath>
+#include <cassert>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using DirectX::BoundingBox;
+
+namespace
+{
+	// SimpleMath(DirectXTK) ̵ ǵ BVH ȿ  ּ 
+	struct Vector3 : DirectX::XMFLOAT3
+	{
+		Vector3() : XMFLOAT3(0.0f, 0.0f, 0.0f) {}
+		Vector3(float x, float y, float z) : XMFLOAT3(x, y, z) {}
+		Vector3(const DirectX::XMFLOAT3& v) : XMFLOAT3(v) {}
+		explicit Vector3(float v) : XMFLOAT3(v, v, v) {}
+
+		Vector3 operator+(const Vector3& rhs) const
+		{
+			return { x + rhs.x, y + rhs.y, z + rhs.z };
+		}
+
+		Vector3 operator-(const Vector3& rhs) const
+		{
+			return { x - rhs.x, y - rhs.y, z - rhs.z };
+		}
+
+		Vector3 operator*(float scale) const
+		{
+			return { x * scale, y * scale, z * scale };
+		}
+
+		static Vector3 Min(const Vector3& a, const Vector3& b)
+		{
+			return { std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z) };
+		}
+
+		static Vector3 Max(const Vector3& a, const Vector3& b)
+		{
+			return { std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z) };
+		}
+	};
+
+	// ġ  ȸ ̺ (active, inside) ũ.  ÿ ιǷ  尡  Ʈ ص .
+	//  ̴  迭 ϰ ׺  Ʈ  
+	struct DepthMaskStack
+	{
+		static constexpr std::uint32_t INLINE_DEPTH = 64;
+
+		std::uint64_t inlineMasks[INLINE_DEPTH * 2];
+		std::vector<std::uint64_t> overflowMasks;
+
+		// [0] active, [1] inside.  At ȣ  ȿ
+		std::uint64_t* At(std::uint32_t depth)
+		{
+			if (depth < INLINE_DEPTH)
+			{
+				return &inlineMasks[depth * 2];
+			}
+
+			std::size_t index = static_cast<std::size_t>(depth - INLINE_DEPTH) * 2;
+			if (overflowMasks.size() < index + 2)
+			{
+				overflowMasks.resize(index + 2);
+			}
+
+			return &overflowMasks[index];
+		}
+	};
+}
+
+constexpr std::uint32_t MAX_LEAF_SIZE = 8;
+// Ʈ ϳ ˻  1    ϳ  ġ 
+constexpr float SAH_TRAVERSAL_COST = 2.0f;
+constexpr std::uint32_t SAH_BIN_COUNT = 16;
+constexpr std::uint32_t PARALLEL_BUILD_THRESHOLD = 4096;
+//     ̸̻鼭 ü 1/4  Remove Compact
+constexpr std::uint32_t AUTO_COMPACT_MIN_FREE_SLOTS = 64;
+// ̵  踸ŭ ̵  ø (  ձ )
+constexpr float FAT_AABB_DISPLACEMENT_MULTIPLIER = 4.0f;
+//   ã⿡  ϳ  ۾   Ʈ ۾ ϳ ũ
+constexpr std::uint32_t PARALLEL_PAIR_TASKS_PER_THREAD = 4;
+constexpr std::uint32_t PARALLEL_PAIR_MOVED_CHUNK = 256;
+
+std::uint32_t MakeObjectID(std::uint32_t handleIndex, std::uint32_t generation)
+{
+	return (generation << BVH::HANDLE_INDEX_BITS) | handleIndex;
+}
+
+Vector3 CalcAABBMin(const BoundingBox& aabb)
+{
+	return { aabb.Center.x - aabb.Extents.x, aabb.Center.y - aabb.Extents.y, aabb.Center.z - aabb.Extents.z };
+}
+
+Vector3 CalcAABBMax(const BoundingBox& aabb)
+{
+	return { aabb.Center.x + aabb.Extents.x, aabb.Center.y + aabb.Extents.y, aabb.Center.z + aabb.Extents.z };
+}
+
+float CalcSurfaceArea(const Vector3& min, const Vector3& max)
+{
+	Vector3 size{ max.x - min.x, max.y - min.y, max.z - min.z };
+
+	return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+BoundingBox MakeWithMinMax(const Vector3& min, const Vector3& max)
+{
+	Vector3 extents{ (max.x - min.x) / 2, (max.y - min.y) / 2, (max.z - min.z) / 2 };
+	Vector3 center{ min.x + extents.x, min.y + extents.y, min.z + extents.z };
+
+	return { center, extents };
+}
+
+//  marginŭ Ű  ̵  θ  ø
+BoundingBox MakeFatAABB(const BoundingBox& aabb, float margin, const Vector3& displacement)
+{
+	Vector3 min = CalcAABBMin(aabb) - Vector3(margin);
+	Vector3 max = CalcAABBMax(aabb) + Vector3(margin);
+
+	Vector3 predicted = displacement * FAT_AABB_DISPLACEMENT_MULTIPLIER;
+	min = Vector3::Min(min, min + predicted);
+	max = Vector3::Max(max, max + predicted);
+
+	return MakeWithMinMax(min, max);
+}
+
+void AddPair(std::vector<BVH::ObjectPair>& outPairs, std::uint32_t first, std::uint32_t second, bool sortIDs)
+{
+	if (sortIDs && second < first)
+	{
+		std::swap(first, second);
+	}
+
+	outPairs.push_back({ first, second });
+}
+
+bool ContainsAABB(const BoundingBox& outer, const BoundingBox& inner)
+{
+	Vector3 outerMin = CalcAABBMin(outer);
+	Vector3 outerMax = CalcAABBMax(outer);
+	Vector3 innerMin = CalcAABBMin(inner);
+	Vector3 innerMax = CalcAABBMax(inner);
+
+	return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z &&
+		innerMax.x <= outerMax.x && innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+}
+
+std::uint32_t CountTrailingZeros(std::uint64_t value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return static_cast<std::uint32_t>(index);
+#else
+	return static_cast<std::uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+struct FrustumPlanes
+{
+	DirectX::XMFLOAT4 planes[6];
+};
+
+enum class PlaneTestResult
+{
+	Outside,
+	Intersect,
+	Inside
+};
+
+FrustumPlanes MakeFrustumPlanes(const DirectX::BoundingFrustum& frustum)
+{
+	DirectX::XMVECTOR planes[6];
+	frustum.GetPlanes(&planes[0], &planes[1], &planes[2], &planes[3], &planes[4], &planes[5]);
+
+	FrustumPlanes result;
+	for (int i = 0; i < 6; ++i)
+	{
+		DirectX::XMStoreFloat4(&result.planes[i], planes[i]);
+	}
+
+	return result;
+}
+
+//     ٱ (DirectXCollision  Ծ)
+PlaneTestResult TestFrustumAABB(const FrustumPlanes& frustum, const BoundingBox& aabb)
+{
+	const auto& c = aabb.Center;
+	const auto& e = aabb.Extents;
+
+	bool inside = true;
+
+	for (const auto& p : frustum.planes)
+	{
+		float distance = p.x * c.x + p.y * c.y + p.z * c.z + p.w;
+		float radius = std::fabs(p.x) * e.x + std::fabs(p.y) * e.y + std::fabs(p.z) * e.z;
+
+		if (distance > radius)
+		{
+			return PlaneTestResult::Outside;
+		}
+
+		if (distance > -radius)
+		{
+			inside = false;
+		}
+	}
+
+	return inside ? PlaneTestResult::Inside : PlaneTestResult::Intersect;
+}
+
+// Slab ׽Ʈ. ϸ  Ÿ(origin ̸ 0) outT 
+bool RayIntersectsAABB(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& invDirection, float maxDistance, const BoundingBox& aabb, float& outT)
+{
+	Vector3 min = CalcAABBMin(aabb);
+	Vector3 max = CalcAABBMax(aabb);
+
+	float tx1 = (min.x - origin.x) * invDirection.x;
+	float tx2 = (max.x - origin.x) * invDirection.x;
+	float tMin = std::min(tx1, tx2);
+	float tMax = std::max(tx1, tx2);
+
+	float ty1 = (min.y - origin.y) * invDirection.y;
+	float ty2 = (max.y - origin.y) * invDirection.y;
+	tMin = std::max(tMin, std::min(ty1, ty2));
+	tMax = std::min(tMax, std::max(ty1, ty2));
+
+	float tz1 = (min.z - origin.z) * invDirection.z;
+	float tz2 = (max.z - origin.z) * invDirection.z;
+	tMin = std::max(tMin, std::min(tz1, tz2));
+	tMax = std::min(tMax, std::max(tz1, tz2));
+
+	tMin = std::max(tMin, 0.0f);
+
+	if (tMin > tMax || tMin > maxDistance)
+	{
+		return false;
+	}
+
+	outT = tMin;
+
+	return true;
+}
+
+std::uint32_t BVH::Insert(const DirectX::BoundingBox& aabb)
+{
+	if (!CanAllocateHandles(1))
+	{
+		assert(false && "BVH handle index overflow");
+		return INVALID_ID;
+	}
+
+	std::uint32_t slot = AllocateObjectSlot(aabb);
+
+	std::uint32_t position;
+	if (!m_freeObjectPositions.empty())
+	{
+		position = m_freeObjectPositions.back();
+		m_freeObjectPositions.pop_back();
+		m_objectIndices[position] = slot;
+	}
+	else
+	{
+		position = static_cast<std::uint32_t>(m_objectIndices.size());
+		m_objectIndices.push_back(slot);
+	}
+
+	std::uint32_t nodeIndex = AllocateNode();
+	m_nodes[nodeIndex].aabb = m_fatAABBs[slot];
+	m_nodes[nodeIndex].firstObject = position;
+	m_nodes[nodeIndex].objectCount = 1;
+
+	m_objectToLeafIndices[slot] = nodeIndex;
+
+	InsertLeaf(nodeIndex);
+
+	return m_objectIDs[slot];
+}
+
+std::vector<std::uint32_t> BVH::Insert(const std::vector<DirectX::BoundingBox>& aabbs)
+{
+	std::vector<std::uint32_t> resultIDs;
+
+	if (aabbs.empty())
+	{
+		return resultIDs;
+	}
+
+	if (!CanAllocateHandles(aabbs.size()))
+	{
+		assert(false && "BVH handle index overflow");
+		return resultIDs;
+	}
+
+	resultIDs.reserve(aabbs.size());
+
+	for (const auto& aabb : aabbs)
+	{
+		std::uint32_t slot = AllocateObjectSlot(aabb);
+
+		resultIDs.push_back(m_objectIDs[slot]);
+	}
+
+	FullyRebuild();
+
+	return resultIDs;
+}
+
+bool BVH::Remove(std::uint32_t id)
+{
+	if (!IsValid(id))
+	{
+		return false;
+	}
+
+	std::uint32_t handleIndex = id & HANDLE_INDEX_MASK;
+	std::uint32_t slot = m_handles[handleIndex].slot;
+	std::uint32_t leafIndex = m_objectToLeafIndices[slot];
+
+	auto& leafNode = m_nodes[leafIndex];
+
+	if (leafNode.objectCount > 1)
+	{
+		//    ĭ ٲ   
+		std::uint32_t first = leafNode.firstObject;
+		std::uint32_t last = first + leafNode.objectCount - 1;
+
+		for (std::uint32_t i = first; i < last; ++i)
+		{
+			if (m_objectIndices[i] == slot)
+			{
+				std::swap(m_objectIndices[i], m_objectIndices[last]);
+				break;
+			}
+		}
+
+		leafNode.objectCount--;
+
+		m_objectIndices[last] = INVALID_INDEX;
+		m_freeObjectPositions.push_back(last);
+
+		RefitLeafAndAncestors(leafIndex);
+	}
+	else
+	{
+		m_objectIndices[leafNode.firstObject] = INVALID_INDEX;
+		m_freeObjectPositions.push_back(leafNode.firstObject);
+
+		if (leafNode.IsRoot())
+		{
+			m_rootIndex = INVALID_INDEX;
+		}
+		else
+		{
+			RemoveLeaf(leafIndex);
+		}
+
+		m_freeNodeIndices.push_back(leafIndex);
+	}
+
+	m_objectToLeafIndices[slot] = INVALID_INDEX;
+	m_objectIDs[slot] = INVALID_ID;
+	m_freeObjectSlots.push_back(slot);
+
+	auto& handle = m_handles[handleIndex];
+	handle.slot = INVALID_INDEX;
+	handle.generation = (handle.generation + 1) & GENERATION_MASK;
+	handle.isMoved = false;
+	m_freeHandles.push_back(handleIndex);
+
+	std::uint32_t freeSlotCount = static_cast<std::uint32_t>(m_freeObjectSlots.size());
+	if (freeSlotCount >= AUTO_COMPACT_MIN_FREE_SLOTS && freeSlotCount * 4 > m_objectAABBs.size())
+	{
+		Compact();
+	}
+
+	return true;
+}
+
+bool BVH::IsValid(std::uint32_t id) const
+{
+	std::uint32_t handleIndex = id & HANDLE_INDEX_MASK;
+
+	if (id == INVALID_ID || handleIndex >= m_handles.size())
+	{
+		return false;
+	}
+
+	const auto& handle = m_handles[handleIndex];
+
+	return handle.slot != INVALID_INDEX && MakeObjectID(handleIndex, handle.generation) == id;
+}
+
+bool BVH::ChangeAABB(std::uint32_t id, const DirectX::BoundingBox& newAABB, const DirectX::XMFLOAT3& displacement)
+{
+	std::uint32_t slot = GetSlot(id);
+	if (slot == INVALID_INDEX)
+	{
+		return false;
+	}
+
+	m_objectAABBs[slot] = newAABB;
+	MarkMoved(id & HANDLE_INDEX_MASK);
+
+	if (!m_useFatAABBs)
+	{
+		m_fatAABBs[slot] = newAABB;
+		m_changedObjectIndices.push_back(slot);
+		return true;
+	}
+
+	//  fat AABB ȿ  Ʈ ״ ֵ 
+	if (ContainsAABB(m_fatAABBs[slot], newAABB))
+	{
+		return false;
+	}
+
+	m_fatAABBs[slot] = MakeFatAABB(newAABB, m_fatMargin, displacement);
+	m_changedObjectIndices.push_back(slot);
+
+	return true;
+}
+
+void BVH::FullyRebuild(bool useSAH, bool useParallel)
+{
+	m_nodes.clear();
+	m_freeNodeIndices.clear();
+	m_rootIndex = INVALID_INDEX;
+
+	// ִ Ը Ƽ ϹǷ  ġ ⼭ 
+	m_objectIndices.clear();
+	m_freeObjectPositions.clear();
+
+	m_useFatAABBs = m_fatMargin > 0.0f;
+
+	for (std::uint32_t slot = 0; slot < m_objectIDs.size(); ++slot)
+	{
+		if (m_objectIDs[slot] != INVALID_ID)
+		{
+			m_objectIndices.push_back(slot);
+
+			m_fatAABBs[slot] = m_useFatAABBs ? MakeFatAABB(m_objectAABBs[slot], m_fatMargin, Vector3()) : m_objectAABBs[slot];
+		}
+	}
+
+	if (!m_objectIndices.empty())
+	{
+		std::uint32_t objectCount = static_cast<std::uint32_t>(m_objectIndices.size());
+
+		//  ġ Է¿ ؼ ǹǷ  ο   Ʈ 
+		m_nodes.resize(objectCount * 2 - 1);
+		m_rootIndex = 0;
+
+		BuildBVH(0, objectCount, m_rootIndex, useSAH, useParallel);
+
+		//   Ʈ  ̸ Ƶ    ڸ 
+		if (m_maxLeafSize > 1)
+		{
+			CompactNodes();
+		}
+	}
+
+	m_changedObjectIndices.clear();
+}
+
+void BVH::Refit()
+{
+	RefitChangedNodes(false);
+}
+
+void BVH::RefitWithRotation()
+{
+	RefitChangedNodes(true);
+}
+
+void BVH::OptimizeObject(std::uint32_t id)
+{
+	std::uint32_t slot = GetSlot(id);
+	if (slot == INVALID_INDEX)
+	{
+		return;
+	}
+
+	std::int32_t leafIndex = m_objectToLeafIndices[slot];
+
+	if (m_nodes[leafIndex].objectCount > 1)
+	{
+		SplitObjectFromLeaf(slot);
+		return;
+	}
+
+	m_nodes[leafIndex].aabb = m_fatAABBs[slot];
+
+	//  ϳ Ʈ ű  
+	if (m_nodes[leafIndex].IsRoot())
+	{
+		return;
+	}
+
+	RemoveLeaf(leafIndex);
+
+	InsertLeaf(leafIndex);
+}
+
+void BVH::SetMaxLeafSize(std::uint32_t maxLeafSize)
+{
+	m_maxLeafSize = std::clamp(maxLeafSize, 1u, MAX_LEAF_SIZE);
+}
+
+std::uint32_t BVH::GetMaxLeafSize() const
+{
+	return m_maxLeafSize;
+}
+
+void BVH::SetFatAABBMargin(float margin)
+{
+	m_fatMargin = std::max(margin, 0.0f);
+}
+
+float BVH::GetFatAABBMargin() const
+{
+	return m_fatMargin;
+}
+
+bool BVH::UsesFatAABBs() const
+{
+	return m_useFatAABBs;
+}
+
+void BVH::CompactNodes()
+{
+	if (m_rootIndex == INVALID_INDEX)
+	{
+		m_nodes.clear();
+		m_freeNodeIndices.clear();
+		return;
+	}
+
+	struct CompactItem
+	{
+		std::uint32_t oldIndex;
+		std::int32_t newParent;
+		bool isLeft;
+	};
+
+	std::vector<BVHNode> compacted;
+	compacted.reserve(m_nodes.size() - m_freeNodeIndices.size());
+
+	std::vector<CompactItem> stack;
+	stack.push_back({ m_rootIndex, -1, false });
+
+	//  ȸ  ٽ ġ ( ڽ θ ٷ  )
+	while (!stack.empty())
+	{
+		CompactItem item = stack.back();
+		stack.pop_back();
+
+		std::uint32_t newIndex = static_cast<std::uint32_t>(compacted.size());
+
+		BVHNode node = m_nodes[item.oldIndex];
+		node.parent = item.newParent;
+		compacted.push_back(node);
+
+		if (item.newParent != -1)
+		{
+			if (item.isLeft)
+			{
+				compacted[item.newParent].left = newIndex;
+			}
+			else
+			{
+				compacted[item.newParent].right = newIndex;
+			}
+		}
+
+		if (node.IsLeaf())
+		{
+			for (std::uint32_t i = 0; i < node.objectCount; ++i)
+			{
+				m_objectToLeafIndices[m_objectIndices[node.firstObject + i]] = newIndex;
+			}
+		}
+		else
+		{
+			stack.push_back({ node.right, static_cast<std::int32_t>(newIndex), false });
+			stack.push_back({ node.left, static_cast<std::int32_t>(newIndex), true });
+		}
+	}
+
+	m_nodes.swap(compacted);
+	m_freeNodeIndices.clear();
+	m_rootIndex = 0;
+}
+
+void BVH::Compact()
+{
+	CompactNodes();
+
+	std::uint32_t oldSlotCount = static_cast<std::uint32_t>(m_objectAABBs.size());
+	std::uint32_t liveCount = oldSlotCount - static_cast<std::uint32_t>(m_freeObjectSlots.size());
+
+	std::vector<std::uint32_t> oldToNewSlots(oldSlotCount, INVALID_INDEX);
+	std::vector<std::uint32_t> newObjectIndices;
+	std::vector<DirectX::BoundingBox> newObjectAABBs;
+	std::vector<DirectX::BoundingBox> newFatAABBs;
+	std::vector<std::uint32_t> newObjectIDs;
+	std::vector<std::uint32_t> newObjectToLeafIndices;
+
+	newObjectIndices.reserve(liveCount);
+	newObjectAABBs.reserve(liveCount);
+	newFatAABBs.reserve(liveCount);
+	newObjectIDs.reserve(liveCount);
+	newObjectToLeafIndices.reserve(liveCount);
+
+	// 尡  ȸ         ä
+	for (std::uint32_t nodeIndex = 0; nodeIndex < m_nodes.size(); ++nodeIndex)
+	{
+		auto& node = m_nodes[nodeIndex];
+		if (!node.IsLeaf())
+		{
+			continue;
+		}
+
+		std::uint32_t newFirst = static_cast<std::uint32_t>(newObjectIndices.size());
+
+		for (std::uint32_t i = 0; i < node.objectCount; ++i)
+		{
+			std::uint32_t oldSlot = m_objectIndices[node.firstObject + i];
+			std::uint32_t newSlot = static_cast<std::uint32_t>(newObjectAABBs.size());
+
+			oldToNewSlots[oldSlot] = newSlot;
+
+			newObjectIndices.push_back(newSlot);
+			newObjectAABBs.push_back(m_objectAABBs[oldSlot]);
+			newFatAABBs.push_back(m_fatAABBs[oldSlot]);
+			newObjectIDs.push_back(m_objectIDs[oldSlot]);
+			newObjectToLeafIndices.push_back(nodeIndex);
+
+			m_handles[m_objectIDs[oldSlot] & HANDLE_INDEX_MASK].slot = newSlot;
+		}
+
+		node.firstObject = newFirst;
+	}
+
+	//  Refit    ϵ   ű
+	std::uint32_t changedCount = 0;
+	for (auto slot : m_changedObjectIndices)
+	{
+		if (oldToNewSlots[slot] != INVALID_INDEX)
+		{
+			m_changedObjectIndices[changedCount++] = oldToNewSlots[slot];
+		}
+	}
+	m_changedObjectIndices.resize(changedCount);
+
+	m_objectIndices.swap(newObjectIndices);
+	m_objectAABBs.swap(newObjectAABBs);
+	m_fatAABBs.swap(newFatAABBs);
+	m_objectIDs.swap(newObjectIDs);
+	m_objectToLeafIndices.swap(newObjectToLeafIndices);
+
+	m_freeObjectSlots.clear();
+	m_freeObjectPositions.clear();
+}
+
+const std::vector<BVHNode>& BVH::GetNodes() const
+{
+    return m_nodes;
+}
+
+const std::vector<std::uint32_t>& BVH::GetObjectIndices() const
+{
+	return m_objectIndices;
+}
+
+const std::vector<DirectX::BoundingBox>& BVH::GetObjectAABBs() const
+{
+	return m_objectAABBs;
+}
+
+const std::vector<std::uint32_t>& BVH::GetObjectIDs() const
+{
+	return m_objectIDs;
+}
+
+std::uint32_t BVH::GetRootIndex() const
+{
+	return m_rootIndex;
+}
+
+float BVH::CalculateSAHCost() const
+{
+	if (m_rootIndex == INVALID_INDEX)
+	{
+		return 0.0f;
+	}
+
+	float rootArea = CalculateSurfaceArea(m_nodes[m_rootIndex].aabb);
+	if (rootArea <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	// 忡  Ȯ(ǥ ) *  忡  
+	float cost = 0.0f;
+
+	std::vector<std::uint32_t> stack;
+	stack.push_back(m_rootIndex);
+
+	while (!stack.empty())
+	{
+		const auto& node = m_nodes[stack.back()];
+		stack.pop_back();
+
+		float probability = CalculateSurfaceArea(node.aabb) / rootArea;
+
+		if (node.IsLeaf())
+		{
+			cost += probability * node.objectCount;
+		}
+		else
+		{
+			cost += probability * SAH_TRAVERSAL_COST;
+
+			stack.push_back(node.left);
+			stack.push_back(node.right);
+		}
+	}
+
+	return cost;
+}
+
+std::uint32_t BVH::CalculateMaxDepth() const
+{
+	if (m_rootIndex == INVALID_INDEX)
+	{
+		return 0;
+	}
+
+	std::uint32_t maxDepth = 0;
+
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> stack;
+	stack.push_back({ m_rootIndex, 1 });
+
+	while (!stack.empty())
+	{
+		auto [nodeIndex, depth] = stack.back();
+		stack.pop_back();
+
+		maxDepth = std::max(maxDepth, depth);
+
+		const auto& node = m_nodes[nodeIndex];
+		if (!node.IsLeaf())
+		{
+			stack.push_back({ node.left, depth + 1 });
+			stack.push_back({ node.right, depth + 1 });
+		}
+	}
+
+	return maxDepth;
+}
+
+std::uint32_t BVH::GetNodeCount() const
+{
+	return static_cast<std::uint32_t>(m_nodes.size() - m_freeNodeIndices.size());
+}
+
+void BVH::QueryFrustum(const DirectX::BoundingFrustum& frustum, std::vector<std::uint32_t>& outObjects) const
+{
+	outObjects.clear();
+
+	FrustumPlanes planes = MakeFrustumPlanes(frustum);
+
+	auto nodeTest = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			PlaneTestResult result = TestFrustumAABB(planes, m_nodes[nodeIndex].aabb);
+
+			if (result == PlaneTestResult::Inside)
+			{
+				//  ԵǸ   ˻  
+				CollectSubtree(nodeIndex, outObjects);
+				return false;
+			}
+
+			return result == PlaneTestResult::Intersect;
+		};
+
+	auto leafVisit = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			const auto& node = m_nodes[nodeIndex];
+
+			for (std::uint32_t i = 0; i < node.objectCount; ++i)
+			{
+				std::uint32_t objIndex = m_objectIndices[node.firstObject + i];
+
+				if ((!m_useFatAABBs && node.objectCount == 1) || TestFrustumAABB(planes, m_objectAABBs[objIndex]) != PlaneTestResult::Outside)
+				{
+					outObjects.push_back(m_objectIDs[objIndex]);
+				}
+			}
+		};
+
+	auto rightFirst = [](std::uint32_t nodeIndex) { return false; };
+
+	Traverse(m_rootIndex, nodeTest, leafVisit, rightFirst);
+}
+
+void BVH::QueryAABB(const DirectX::BoundingBox& aabb, std::vector<std::uint32_t>& outObjects) const
+{
+	outObjects.clear();
+
+	auto nodeTest = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			return m_nodes[nodeIndex].aabb.Intersects(aabb);
+		};
+
+	auto leafVisit = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			const auto& node = m_nodes[nodeIndex];
+
+			for (std::uint32_t i = 0; i < node.objectCount; ++i)
+			{
+				std::uint32_t objIndex = m_objectIndices[node.firstObject + i];
+
+				if ((!m_useFatAABBs && node.objectCount == 1) || m_objectAABBs[objIndex].Intersects(aabb))
+				{
+					outObjects.push_back(m_objectIDs[objIndex]);
+				}
+			}
+		};
+
+	auto rightFirst = [](std::uint32_t nodeIndex) { return false; };
+
+	Traverse(m_rootIndex, nodeTest, leafVisit, rightFirst);
+}
+
+void BVH::QuerySphere(const DirectX::BoundingSphere& sphere, std::vector<std::uint32_t>& outObjects) const
+{
+	outObjects.clear();
+
+	auto nodeTest = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			return m_nodes[nodeIndex].aabb.Intersects(sphere);
+		};
+
+	auto leafVisit = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			const auto& node = m_nodes[nodeIndex];
+
+			for (std::uint32_t i = 0; i < node.objectCount; ++i)
+			{
+				std::uint32_t objIndex = m_objectIndices[node.firstObject + i];
+
+				if ((!m_useFatAABBs && node.objectCount == 1) || m_objectAABBs[objIndex].Intersects(sphere))
+				{
+					outObjects.push_back(m_objectIDs[objIndex]);
+				}
+			}
+		};
+
+	auto rightFirst = [](std::uint32_t nodeIndex) { return false; };
+
+	Traverse(m_rootIndex, nodeTest, leafVisit, rightFirst);
+}
+
+bool BVH::Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+	std::uint32_t& outObject, float& outDistance) const
+{
+	Vector3 invDirection{ 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+	float closest = maxDistance;
+	bool hit = false;
+
+	auto nodeTest = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			float t;
+			return RayIntersectsAABB(origin, invDirection, closest, m_nodes[nodeIndex].aabb, t);
+		};
+
+	auto leafVisit = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			const auto& node = m_nodes[nodeIndex];
+
+			for (std::uint32_t i = 0; i < node.objectCount; ++i)
+			{
+				std::uint32_t objIndex = m_objectIndices[node.firstObject + i];
+
+				float t;
+				if (RayIntersectsAABB(origin, invDirection, closest, m_objectAABBs[objIndex], t))
+				{
+					closest = t;
+					outObject = m_objectIDs[objIndex];
+					hit = true;
+				}
+			}
+		};
+
+	//     ڽĺ 湮ؾ closest  پ
+	auto rightFirst = [&](std::uint32_t nodeIndex)
+		{
+			const auto& node = m_nodes[nodeIndex];
+			const auto& l = m_nodes[node.left].aabb.Center;
+			const auto& r = m_nodes[node.right].aabb.Center;
+
+			return (r.x - l.x) * direction.x + (r.y - l.y) * direction.y + (r.z - l.z) * direction.z < 0.0f;
+		};
+
+	Traverse(m_rootIndex, nodeTest, leafVisit, rightFirst);
+
+	if (hit)
+	{
+		outDistance = closest;
+	}
+
+	return hit;
+}
+
+bool BVH::Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+	const RayHitTest& hitTest, std::uint32_t& outObject, float& outDistance) const
+{
+	Vector3 invDirection{ 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+	float closest = maxDistance;
+	bool hit = false;
+
+	auto nodeTest = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			float t;
+			return RayIntersectsAABB(origin, invDirection, closest, m_nodes[nodeIndex].aabb, t);
+		};
+
+	auto leafVisit = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			const auto& node = m_nodes[nodeIndex];
+
+			for (std::uint32_t i = 0; i < node.objectCount; ++i)
+			{
+				std::uint32_t objIndex = m_objectIndices[node.firstObject + i];
+
+				float t;
+				if (!RayIntersectsAABB(origin, invDirection, closest, m_objectAABBs[objIndex], t))
+				{
+					continue;
+				}
+
+				float distance = hitTest(m_objectIDs[objIndex], closest);
+				if (distance >= 0.0f && distance <= closest)
+				{
+					closest = distance;
+					outObject = m_objectIDs[objIndex];
+					hit = true;
+				}
+			}
+		};
+
+	auto rightFirst = [&](std::uint32_t nodeIndex)
+		{
+			const auto& node = m_nodes[nodeIndex];
+			const auto& l = m_nodes[node.left].aabb.Center;
+			const auto& r = m_nodes[node.right].aabb.Center;
+
+			return (r.x - l.x) * direction.x + (r.y - l.y) * direction.y + (r.z - l.z) * direction.z < 0.0f;
+		};
+
+	Traverse(m_rootIndex, nodeTest, leafVisit, rightFirst);
+
+	if (hit)
+	{
+		outDistance = closest;
+	}
+
+	return hit;
+}
+
+void BVH::QueryFrustums(const std::vector<DirectX::BoundingFrustum>& frustums, std::vector<std::vector<std::uint32_t>>& outObjects) const
+{
+	constexpr std::size_t BATCH_SIZE = 64;
+
+	outObjects.resize(frustums.size());
+	for (auto& objects : outObjects)
+	{
+		objects.clear();
+	}
+
+	FrustumPlanes planes[BATCH_SIZE];
+	DepthMaskStack maskStack;
+
+	for (std::size_t batchBegin = 0; batchBegin < frustums.size(); batchBegin += BATCH_SIZE)
+	{
+		std::size_t batchCount = std::min(BATCH_SIZE, frustums.size() - batchBegin);
+
+		for (std::size_t i = 0; i < batchCount; ++i)
+		{
+			planes[i] = MakeFrustumPlanes(frustums[batchBegin + i]);
+		}
+
+		// depth 0 Ʈ θ :   ˻ 
+		std::uint64_t* rootMasks = maskStack.At(0);
+		rootMasks[0] = batchCount == 64 ? ~0ull : (1ull << batchCount) - 1;
+		rootMasks[1] = 0;
+
+		auto nodeTest = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+			{
+				const std::uint64_t* masks = maskStack.At(depth);
+				std::uint64_t active = masks[0];
+				std::uint64_t inside = masks[1];
+
+				std::uint64_t pending = active;
+				while (pending != 0)
+				{
+					std::uint32_t bit = CountTrailingZeros(pending);
+					pending &= pending - 1;
+
+					PlaneTestResult result = TestFrustumAABB(planes[bit], m_nodes[nodeIndex].aabb);
+
+					if (result != PlaneTestResult::Intersect)
+					{
+						active &= ~(1ull << bit);
+					}
+
+					if (result == PlaneTestResult::Inside)
+					{
+						inside |= 1ull << bit;
+					}
+				}
+
+				std::uint64_t* childMasks = maskStack.At(depth + 1);
+				childMasks[0] = active;
+				childMasks[1] = inside;
+
+				return (active | inside) != 0;
+			};
+
+		auto leafVisit = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+			{
+				const auto& node = m_nodes[nodeIndex];
+
+				const std::uint64_t* masks = maskStack.At(depth + 1);
+				std::uint64_t active = masks[0];
+				std::uint64_t inside = masks[1];
+
+				//  Ʈ ϳ  AABB == Ʈ AABB (fat AABB   )
+				if (node.objectCount == 1 && !m_useFatAABBs)
+				{
+					inside |= active;
+					active = 0;
+				}
+
+				while (inside != 0)
+				{
+					std::uint32_t bit = CountTrailingZeros(inside);
+					inside &= inside - 1;
+
+					auto& objects = outObjects[batchBegin + bit];
+					for (std::uint32_t i = 0; i < node.objectCount; ++i)
+					{
+						objects.push_back(m_objectIDs[m_objectIndices[node.firstObject + i]]);
+					}
+				}
+
+				while (active != 0)
+				{
+					std::uint32_t bit = CountTrailingZeros(active);
+					active &= active - 1;
+
+					auto& objects = outObjects[batchBegin + bit];
+					for (std::uint32_t i = 0; i < node.objectCount; ++i)
+					{
+						std::uint32_t objIndex = m_objectIndices[node.firstObject + i];
+
+						if (TestFrustumAABB(planes[bit], m_objectAABBs[objIndex]) != PlaneTestResult::Outside)
+						{
+							objects.push_back(m_objectIDs[objIndex]);
+						}
+					}
+				}
+			};
+
+		auto rightFirst = [](std::uint32_t nodeIndex) { return false; };
+
+		Traverse(m_rootIndex, nodeTest, leafVisit, rightFirst);
+	}
+}
+
+void BVH::FindOverlappingPairs(std::vector<ObjectPair>& outPairs, bool movedOnly, bool useParallel) const
+{
+	outPairs.clear();
+
+	if (m_rootIndex == INVALID_INDEX)
+	{
+		return;
+	}
+
+	if (movedOnly)
+	{
+		FindPairsWithMovedObjects(*this, true, outPairs, useParallel);
+	}
+	else
+	{
+		FindPairsWithDescent(*this, true, outPairs, useParallel);
+	}
+}
+
+void BVH::FindOverlappingPairs(const BVH& other, std::vector<ObjectPair>& outPairs, bool movedOnly, bool useParallel) const
+{
+	outPairs.clear();
+
+	if (m_rootIndex == INVALID_INDEX || other.m_rootIndex == INVALID_INDEX)
+	{
+		return;
+	}
+
+	if (movedOnly)
+	{
+		FindPairsWithMovedObjects(other, false, outPairs, useParallel);
+	}
+	else
+	{
+		FindPairsWithDescent(other, false, outPairs, useParallel);
+	}
+}
+
+void BVH::ClearMovedObjects()
+{
+	for (auto id : m_movedObjects)
+	{
+		if (IsValid(id))
+		{
+			m_handles[id & HANDLE_INDEX_MASK].isMoved = false;
+		}
+	}
+
+	m_movedObjects.clear();
+}
+
+void BVH::SplitObjectFromLeaf(std::uint32_t slot)
+{
+	std::uint32_t leafIndex = m_objectToLeafIndices[slot];
+
+	//  Ʈ    ĭ ű,  ĭ   
+	std::uint32_t first = m_nodes[leafIndex].firstObject;
+	std::uint32_t last = first + m_nodes[leafIndex].objectCount - 1;
+
+	for (std::uint32_t i = first; i < last; ++i)
+	{
+		if (m_objectIndices[i] == slot)
+		{
+			std::swap(m_objectIndices[i], m_objectIndices[last]);
+			break;
+		}
+	}
+
+	m_nodes[leafIndex].objectCount--;
+
+	RefitLeafAndAncestors(leafIndex);
+
+	std::uint32_t newLeafIndex = AllocateNode();
+
+	m_nodes[newLeafIndex].aabb = m_fatAABBs[slot];
+	m_nodes[newLeafIndex].firstObject = last;
+	m_nodes[newLeafIndex].objectCount = 1;
+
+	m_objectToLeafIndices[slot] = newLeafIndex;
+
+	InsertLeaf(newLeafIndex);
+}
+
+bool BVH::CanAllocateHandles(std::size_t count) const
+{
+	//  ڵ  , ڶ ŭ  ε 
+	std::size_t newHandleCount = count > m_freeHandles.size() ? count - m_freeHandles.size() : 0;
+
+	return m_handles.size() + newHandleCount <= MAX_HANDLE_COUNT;
+}
+
+std::uint32_t BVH::AllocateObjectSlot(const DirectX::BoundingBox& aabb)
+{
+	std::uint32_t slot;
+	if (!m_freeObjectSlots.empty())
+	{
+		slot = m_freeObjectSlots.back();
+		m_freeObjectSlots.pop_back();
+	}
+	else
+	{
+		slot = static_cast<std::uint32_t>(m_objectAABBs.size());
+		m_objectAABBs.emplace_back();
+		m_fatAABBs.emplace_back();
+		m_objectIDs.push_back(INVALID_ID);
+		m_objectToLeafIndices.push_back(INVALID_INDEX);
+	}
+
+	std::uint32_t handleIndex;
+	if (!m_freeHandles.empty())
+	{
+		handleIndex = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	else
+	{
+		handleIndex = static_cast<std::uint32_t>(m_handles.size());
+		m_handles.push_back({});
+	}
+
+	m_handles[handleIndex].slot = slot;
+
+	m_objectAABBs[slot] = aabb;
+	m_fatAABBs[slot] = m_useFatAABBs ? MakeFatAABB(aabb, m_fatMargin, Vector3()) : aabb;
+	m_objectIDs[slot] = MakeObjectID(handleIndex, m_handles[handleIndex].generation);
+
+	//   Ʈ   ؾ movedOnly  ã⿡  
+	MarkMoved(handleIndex);
+
+	return slot;
+}
+
+std::uint32_t BVH::GetSlot(std::uint32_t id) const
+{
+	if (!IsValid(id))
+	{
+		return INVALID_INDEX;
+	}
+
+	return m_handles[id & HANDLE_INDEX_MASK].slot;
+}
+
+void BVH::RefitChangedNodes(bool useRotation)
+{
+	if (m_rootIndex == INVALID_INDEX)
+	{
+		m_changedObjectIndices.clear();
+		return;
+	}
+
+	if (m_dirtyNodeFlags.size() < m_nodes.size())
+	{
+		m_dirtyNodeFlags.resize(m_nodes.size(), 0);
+	}
+
+	// ٲ  ö󰡸 ǥ. ̹ ǥõ 带    ٸ  ǥ  
+	for (auto slot : m_changedObjectIndices)
+	{
+		std::uint32_t leafIndex = m_objectToLeafIndices[slot];
+		if (leafIndex == INVALID_INDEX)
+		{
+			continue;
+		}
+
+		std::int32_t curr = static_cast<std::int32_t>(leafIndex);
+		while (curr != -1 && m_dirtyNodeFlags[curr] == 0)
+		{
+			m_dirtyNodeFlags[curr] = 1;
+			curr = m_nodes[curr].parent;
+		}
+	}
+
+	m_changedObjectIndices.clear();
+
+	if (m_dirtyNodeFlags[m_rootIndex] == 0)
+	{
+		return;
+	}
+
+	// ǥõ 常  ȸ   Ųٷ óϸ ڽ ׻ θ𺸴  ŵ
+	m_dirtyNodes.clear();
+	m_dirtyNodes.push_back(m_rootIndex);
+
+	for (std::size_t i = 0; i < m_dirtyNodes.size(); ++i)
+	{
+		const auto& node = m_nodes[m_dirtyNodes[i]];
+		if (node.IsLeaf())
+		{
+			continue;
+		}
+
+		if (m_dirtyNodeFlags[node.left] != 0)
+		{
+			m_dirtyNodes.push_back(node.left);
+		}
+
+		if (m_dirtyNodeFlags[node.right] != 0)
+		{
+			m_dirtyNodes.push_back(node.right);
+		}
+	}
+
+	for (auto it = m_dirtyNodes.rbegin(); it != m_dirtyNodes.rend(); ++it)
+	{
+		std::uint32_t nodeIndex = *it;
+		auto& node = m_nodes[nodeIndex];
+
+		m_dirtyNodeFlags[nodeIndex] = 0;
+
+		if (node.IsLeaf())
+		{
+			Vector3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+			Vector3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+			for (std::uint32_t i = 0; i < node.objectCount; ++i)
+			{
+				const auto& bounds = m_fatAABBs[m_objectIndices[node.firstObject + i]];
+
+				min = Vector3::Min(min, CalcAABBMin(bounds));
+				max = Vector3::Max(max, CalcAABBMax(bounds));
+			}
+
+			node.aabb = MakeWithMinMax(min, max);
+			continue;
+		}
+
+		BoundingBox::CreateMerged(node.aabb, m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+
+		if (useRotation)
+		{
+			// ȸ  θ AABB TryRotation ȿ ٽ յ
+			TryRotation(static_cast<std::int32_t>(nodeIndex));
+		}
+	}
+}
+
+void BVH::RefitLeafAndAncestors(std::uint32_t leafIndex)
+{
+	auto& leafNode = m_nodes[leafIndex];
+
+	Vector3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+	Vector3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	for (std::uint32_t i = 0; i < leafNode.objectCount; ++i)
+	{
+		const auto& bounds = m_fatAABBs[m_objectIndices[leafNode.firstObject + i]];
+
+		min = Vector3::Min(min, CalcAABBMin(bounds));
+		max = Vector3::Max(max, CalcAABBMax(bounds));
+	}
+
+	leafNode.aabb = MakeWithMinMax(min, max);
+
+	std::int32_t curr = leafNode.parent;
+	while (curr != -1)
+	{
+		auto& node = m_nodes[curr];
+		BoundingBox::CreateMerged(node.aabb, m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+		curr = node.parent;
+	}
+}
+
+void BVH::BuildBVH(std::uint32_t begin, std::uint32_t end, std::uint32_t nodeIndex, bool useSAH, bool useParallel)
+{
+	Vector3 centerMin{ FLT_MAX, FLT_MAX, FLT_MAX };
+	Vector3 centerMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	Vector3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+	Vector3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	for (std::uint32_t i = begin; i < end; ++i)
+	{
+		const auto& bounds = m_fatAABBs[m_objectIndices[i]];
+		centerMin = Vector3::Min(centerMin, bounds.Center);
+		centerMax = Vector3::Max(centerMax, bounds.Center);
+		min = Vector3::Min(min, CalcAABBMin(bounds));
+		max = Vector3::Max(max, CalcAABBMax(bounds));
+	}
+
+	m_nodes[nodeIndex].aabb = MakeWithMinMax(min, max);
+
+	std::uint32_t count = end - begin;
+	bool makeLeaf = count == 1;
+	std::uint32_t mid = 0;
+
+	if (!makeLeaf)
+	{
+		if (useSAH)
+		{
+			float splitCost;
+			mid = SplitWithSAH(begin, end, centerMin, centerMax, splitCost);
+
+			//    δ 뺸 ũ  
+			float area = CalcSurfaceArea(min, max);
+			float leafCost = area * count;
+			makeLeaf = count <= m_maxLeafSize && leafCost <= area * SAH_TRAVERSAL_COST + splitCost;
+		}
+		else if (count <= m_maxLeafSize)
+		{
+			makeLeaf = true;
+		}
+		else
+		{
+			mid = SplitWithMedian(begin, end, centerMin, centerMax);
+		}
+	}
+
+	if (makeLeaf)
+	{
+		m_nodes[nodeIndex].firstObject = begin;
+		m_nodes[nodeIndex].objectCount = count;
+
+		for (std::uint32_t i = begin; i < end; ++i)
+		{
+			m_objectToLeafIndices[m_objectIndices[i]] = nodeIndex;
+		}
+
+		return;
+	}
+
+	// Ʈ n Ʈ 带 ִ 2n-1 ϹǷ ڽ   ̸   
+	std::uint32_t leftIndex = nodeIndex + 1;
+	std::uint32_t rightIndex = nodeIndex + 2 * (mid - begin);
+
+	if (useParallel && end - begin >= PARALLEL_BUILD_THRESHOLD)
+	{
+		JobSystem::Counter counter;
+		JobSystem::Get().Dispatch(counter, [=]()
+			{
+				BuildBVH(begin, mid, leftIndex, useSAH, useParallel);
+			});
+
+		BuildBVH(mid, end, rightIndex, useSAH, useParallel);
+
+		JobSystem::Get().Wait(counter);
+	}
+	else
+	{
+		BuildBVH(begin, mid, leftIndex, useSAH, useParallel);
+		BuildBVH(mid, end, rightIndex, useSAH, useParallel);
+	}
+
+	m_nodes[nodeIndex].left = leftIndex;
+	m_nodes[nodeIndex].right = rightIndex;
+
+	m_nodes[leftIndex].parent = nodeIndex;
+	m_nodes[rightIndex].parent = nodeIndex;
+}
+
+std::uint32_t BVH::SplitWithMedian(std::uint32_t begin, std::uint32_t end, const DirectX::XMFLOAT3& centerMin, const DirectX::XMFLOAT3& centerMax)
+{
+	float lengthX = centerMax.x - centerMin.x;
+	float lengthY = centerMax.y - centerMin.y;
+	float lengthZ = centerMax.z - centerMin.z;
+
+	std::uint32_t mid = begin + (end - begin) / 2;
+
+	//  ⸸ ϸ ǹǷ ü   nth_element
+	if (lengthX > lengthY && lengthX > lengthZ)
+	{
+		std::nth_element(m_objectIndices.begin() + begin, m_objectIndices.begin() + mid, m_objectIndices.begin() + end,
+			[this](auto a, auto b)
+			{
+				return m_fatAABBs[a].Center.x < m_fatAABBs[b].Center.x;
+			}
+		);
+	}
+	else if (lengthY > lengthX && lengthY > lengthZ)
+	{
+		std::nth_element(m_objectIndices.begin() + begin, m_objectIndices.begin() + mid, m_objectIndices.begin() + end,
+			[this](auto a, auto b)
+			{
+				return m_fatAABBs[a].Center.y < m_fatAABBs[b].Center.y;
+			}
+		);
+	}
+	else
+	{
+		std::nth_element(m_objectIndices.begin() + begin, m_objectIndices.begin() + mid, m_objectIndices.begin() + end,
+			[this](auto a, auto b)
+			{
+				return m_fatAABBs[a].Center.z < m_fatAABBs[b].Center.z;
+			}
+		);
+	}
+
+	return mid;
+}
+
+std::uint32_t BVH::SplitWithSAH(std::uint32_t begin, std::uint32_t end, const DirectX::XMFLOAT3& centerMin, const DirectX::XMFLOAT3& centerMax, float& outCost)
+{
+	//    ߽    ,  迡 SAH  
+	struct Bin
+	{
+		Vector3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+		Vector3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		std::uint32_t count = 0;
+	};
+
+	Bin bins[3][SAH_BIN_COUNT];
+	float binScales[3];
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float axisLength = (&centerMax.x)[axis] - (&centerMin.x)[axis];
+
+		// ߽      
+		binScales[axis] = axisLength > 0.0f ? SAH_BIN_COUNT / axisLength : 0.0f;
+	}
+
+	// Ʈ   о     ä
+	for (std::uint32_t i = begin; i < end; ++i)
+	{
+		const auto& bounds = m_fatAABBs[m_objectIndices[i]];
+		Vector3 boundsMin = CalcAABBMin(bounds);
+		Vector3 boundsMax = CalcAABBMax(bounds);
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			std::uint32_t binIndex = std::min(SAH_BIN_COUNT - 1,
+				static_cast<std::uint32_t>(((&bounds.Center.x)[axis] - (&centerMin.x)[axis]) * binScales[axis]));
+
+			auto& bin = bins[axis][binIndex];
+			bin.min = Vector3::Min(bin.min, boundsMin);
+			bin.max = Vector3::Max(bin.max, boundsMax);
+			bin.count++;
+		}
+	}
+
+	float bestCost = FLT_MAX;
+	int bestAxis = -1;
+	std::uint32_t bestSplit = 0;
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		if (binScales[axis] == 0.0f)
+		{
+			continue;
+		}
+
+		// ʿ  /
+		float rightAreas[SAH_BIN_COUNT - 1];
+		std::uint32_t rightCounts[SAH_BIN_COUNT - 1];
+
+		Vector3 rightMin{ FLT_MAX, FLT_MAX, FLT_MAX };
+		Vector3 rightMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		std::uint32_t rightCount = 0;
+
+		for (std::uint32_t i = SAH_BIN_COUNT - 1; i > 0; --i)
+		{
+			rightMin = Vector3::Min(rightMin, bins[axis][i].min);
+			rightMax = Vector3::Max(rightMax, bins[axis][i].max);
+			rightCount += bins[axis][i].count;
+
+			rightAreas[i - 1] = CalcSurfaceArea(rightMin, rightMax);
+			rightCounts[i - 1] = rightCount;
+		}
+
+		Vector3 leftMin{ FLT_MAX, FLT_MAX, FLT_MAX };
+		Vector3 leftMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		std::uint32_t leftCount = 0;
+
+		// split °  
+		for (std::uint32_t split = 0; split < SAH_BIN_COUNT - 1; ++split)
+		{
+			leftMin = Vector3::Min(leftMin, bins[axis][split].min);
+			leftMax = Vector3::Max(leftMax, bins[axis][split].max);
+			leftCount += bins[axis][split].count;
+
+			if (leftCount == 0 || rightCounts[split] == 0)
+			{
+				continue;
+			}
+
+			float cost = CalcSurfaceArea(leftMin, leftMax) * leftCount + rightAreas[split] * rightCounts[split];
+
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = split;
+			}
+		}
+	}
+
+	std::uint32_t mid = begin + (end - begin) / 2;
+
+	if (bestAxis != -1)
+	{
+		float axisMin = (&centerMin.x)[bestAxis];
+		float binScale = binScales[bestAxis];
+
+		auto midIter = std::partition(m_objectIndices.begin() + begin, m_objectIndices.begin() + end,
+			[&](auto index)
+			{
+				float center = (&m_fatAABBs[index].Center.x)[bestAxis];
+				std::uint32_t binIndex = std::min(SAH_BIN_COUNT - 1, static_cast<std::uint32_t>((center - axisMin) * binScale));
+
+				return binIndex <= bestSplit;
+			}
+		);
+
+		mid = static_cast<std::uint32_t>(midIter - m_objectIndices.begin());
+	}
+
+	// ߽  ļ     ݺ ( ʿ)
+	if (mid == begin || mid == end)
+	{
+		mid = begin + (end - begin) / 2;
+	}
+
+	outCost = bestCost;
+
+	return mid;
+}
+
+// θ ͸  ö󰡴   ȸ.
+// nodeTest(node, depth) false  带 ǳʶٰ,   leafVisit(node, depth) 
+template<typename NodeTest, typename LeafVisit, typename RightFirst>
+void BVH::Traverse(std::uint32_t startIndex, NodeTest& nodeTest, LeafVisit& leafVisit, RightFirst& rightFirst) const
+{
+	if (startIndex == INVALID_INDEX)
+	{
+		return;
+	}
+
+	enum class From
+	{
+		Parent,
+		FirstChild,
+		SecondChild
+	};
+
+	std::uint32_t current = startIndex;
+	std::uint32_t depth = 0;
+	From from = From::Parent;
+
+	while (true)
+	{
+		const auto& node = m_nodes[current];
+
+		if (from == From::Parent)
+		{
+			if (nodeTest(current, depth))
+			{
+				if (node.IsLeaf())
+				{
+					leafVisit(current, depth);
+				}
+				else
+				{
+					current = rightFirst(current) ? node.right : node.left;
+					++depth;
+					continue;
+				}
+			}
+		}
+		else if (from == From::FirstChild)
+		{
+			current = rightFirst(current) ? node.left : node.right;
+			from = From::Parent;
+			++depth;
+			continue;
+		}
+
+		//  ȸ  θ 
+		if (current == startIndex)
+		{
+			break;
+		}
+
+		std::uint32_t parentIndex = static_cast<std::uint32_t>(node.parent);
+		std::uint32_t firstChild = rightFirst(parentIndex) ? m_nodes[parentIndex].right : m_nodes[parentIndex].left;
+
+		from = (firstChild == current) ? From::FirstChild : From::SecondChild;
+		current = parentIndex;
+		--depth;
+	}
+}
+
+void BVH::CollectSubtree(std::uint32_t startIndex, std::vector<std::uint32_t>& outObjects) const
+{
+	auto nodeTest = [](std::uint32_t nodeIndex, std::uint32_t depth) { return true; };
+
+	auto leafVisit = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			const auto& node = m_nodes[nodeIndex];
+
+			for (std::uint32_t i = 0; i < node.objectCount; ++i)
+			{
+				outObjects.push_back(m_objectIDs[m_objectIndices[node.firstObject + i]]);
+			}
+		};
+
+	auto rightFirst = [](std::uint32_t nodeIndex) { return false; };
+
+	Traverse(startIndex, nodeTest, leafVisit, rightFirst);
+}
+
+template<typename Visit>
+void BVH::VisitOverlaps(const DirectX::BoundingBox& aabb, Visit& visit) const
+{
+	auto nodeTest = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			return m_nodes[nodeIndex].aabb.Intersects(aabb);
+		};
+
+	auto leafVisit = [&](std::uint32_t nodeIndex, std::uint32_t depth)
+		{
+			const auto& node = m_nodes[nodeIndex];
+
+			for (std::uint32_t i = 0; i < node.objectCount; ++i)
+			{
+				std::uint32_t objIndex = m_objectIndices[node.firstObject + i];
+
+				if (m_objectAABBs[objIndex].Intersects(aabb))
+				{
+					visit(objIndex);
+				}
+			}
+		};
+
+	auto rightFirst = [](std::uint32_t nodeIndex) { return false; };
+
+	Traverse(m_rootIndex, nodeTest, leafVisit, rightFirst);
+}
+
+void BVH::MarkMoved(std::uint32_t handleIndex)
+{
+	auto& handle = m_handles[handleIndex];
+	if (handle.isMoved)
+	{
+		return;
+	}
+
+	handle.isMoved = true;
+	m_movedObjects.push_back(MakeObjectID(handleIndex, handle.generation));
+}
+
+void BVH::FindPairsWithDescent(const BVH& other, bool isSelf, std::vector<ObjectPair>& outPairs, bool useParallel) const
+{
+	std::vector<NodePair> stack;
+	stack.push_back({ m_rootIndex, other.m_rootIndex });
+
+	std::uint32_t workerCount = useParallel ? JobSystem::Get().GetWorkerCount() : 0;
+
+	if (workerCount == 0)
+	{
+		while (!stack.empty())
+		{
+			NodePair pair = stack.back();
+			stack.pop_back();
+
+			ExpandNodePair(other, isSelf, pair, stack, outPairs);
+		}
+
+		return;
+	}
+
+	// ۾        ܰ辿 ħ
+	std::size_t targetTaskCount = static_cast<std::size_t>(workerCount + 1) * PARALLEL_PAIR_TASKS_PER_THREAD;
+	std::vector<NodePair> level;
+
+	while (!stack.empty() && stack.size() < targetTaskCount)
+	{
+		level.swap(stack);
+		stack.clear();
+
+		for (const auto& pair : level)
+		{
+			ExpandNodePair(other, isSelf, pair, stack, outPairs);
+		}
+	}
+
+	// ۾      ̹Ƿ   Ź 
+	std::vector<std::vector<ObjectPair>> taskPairs(stack.size());
+	JobSystem::Counter counter;
+
+	for (std::size_t i = 0; i < stack.size(); ++i)
+	{
+		JobSystem::Get().Dispatch(counter, [&, i]()
+			{
+				std::vector<NodePair> taskStack{ stack[i] };
+
+				while (!taskStack.empty())
+				{
+					NodePair pair = taskStack.back();
+					taskStack.pop_back();
+
+					ExpandNodePair(other, isSelf, pair, taskStack, taskPairs[i]);
+				}
+			});
+	}
+
+	JobSystem::Get().Wait(counter);
+
+	for (const auto& pairs : taskPairs)
+	{
+		outPairs.insert(outPairs.end(), pairs.begin(), pairs.end());
+	}
+}
+
+void BVH::FindPairsWithMovedObjects(const BVH& other, bool isSelf, std::vector<ObjectPair>& outPairs, bool useParallel) const
+{
+	struct MovedTask
+	{
+		const BVH* movedTree;
+		const BVH* targetTree;
+		std::size_t begin;
+		std::size_t end;
+	};
+
+	//  Ʈ  Ʈ other ˻ϰ, Ʈ   other  Ʈ  Ʈ ˻
+	std::vector<MovedTask> tasks;
+
+	auto addTasks = [&](const BVH& movedTree, const BVH& targetTree)
+		{
+			std::size_t count = movedTree.m_movedObjects.size();
+			for (std::size_t begin = 0; begin < count; begin += PARALLEL_PAIR_MOVED_CHUNK)
+			{
+				tasks.push_back({ &movedTree, &targetTree, begin, std::min<std::size_t>(begin + PARALLEL_PAIR_MOVED_CHUNK, count) });
+			}
+		};
+
+	addTasks(*this, other);
+	if (!isSelf)
+	{
+		addTasks(other, *this);
+	}
+
+	auto runTask = [this, isSelf](const MovedTask& task, std::vector<ObjectPair>& pairs)
+		{
+			const BVH& movedTree = *task.movedTree;
+			const BVH& targetTree = *task.targetTree;
+			bool movedIsThis = &movedTree == this;
+
+			for (std::size_t i = task.begin; i < task.end; ++i)
+			{
+				std::uint32_t id = movedTree.m_movedObjects[i];
+				if (!movedTree.IsValid(id))
+				{
+					continue;
+				}
+
+				auto visit = [&](std::uint32_t targetSlot)
+					{
+						std::uint32_t targetID = targetTree.m_objectIDs[targetSlot];
+						bool targetMoved = targetTree.m_handles[targetID & HANDLE_INDEX_MASK].isMoved;
+
+						if (isSelf)
+						{
+							//    ID   ó  
+							if (targetID != id && !(targetMoved && targetID < id))
+							{
+								AddPair(pairs, id, targetID, true);
+							}
+						}
+						else if (movedIsThis)
+						{
+							pairs.push_back({ id, targetID });
+						}
+						else if (!targetMoved)
+						{
+							pairs.push_back({ targetID, id });
+						}
+					};
+
+				std::uint32_t slot = movedTree.m_handles[id & HANDLE_INDEX_MASK].slot;
+				targetTree.VisitOverlaps(movedTree.m_objectAABBs[slot], visit);
+			}
+		};
+
+	if (!useParallel || JobSystem::Get().GetWorkerCount() == 0 || tasks.size() <= 1)
+	{
+		for (const auto& task : tasks)
+		{
+			runTask(task, outPairs);
+		}
+
+		return;
+	}
+
+	std::vector<std::vector<ObjectPair>> taskPairs(tasks.size());
+	JobSystem::Counter counter;
+
+	for (std::size_t i = 0; i < tasks.size(); ++i)
+	{
+		JobSystem::Get().Dispatch(counter, [&, i]()
+			{
+				runTask(tasks[i], taskPairs[i]);
+			});
+	}
+
+	JobSystem::Get().Wait(counter);
+
+	for (const auto& pairs : taskPairs)
+	{
+		outPairs.insert(outPairs.end(), pairs.begin(), pairs.end());
+	}
+}
+
+void BVH::ExpandNodePair(const BVH& other, bool isSelf, const NodePair& pair, std::vector<NodePair>& stack, std::vector<ObjectPair>& outPairs) const
+{
+	const auto& nodeA = m_nodes[pair.a];
+	const auto& nodeB = other.m_nodes[pair.b];
+
+	if (isSelf && pair.a == pair.b)
+	{
+		if (nodeA.IsLeaf())
+		{
+			//    Ʈ
+			for (std::uint32_t i = 0; i < nodeA.objectCount; ++i)
+			{
+				std::uint32_t slotI = m_objectIndices[nodeA.firstObject + i];
+
+				for (std::uint32_t j = i + 1; j < nodeA.objectCount; ++j)
+				{
+					std::uint32_t slotJ = m_objectIndices[nodeA.firstObject + j];
+
+					if (m_objectAABBs[slotI].Intersects(m_objectAABBs[slotJ]))
+					{
+						AddPair(outPairs, m_objectIDs[slotI], m_objectIDs[slotJ], true);
+					}
+				}
+			}
+		}
+		else
+		{
+			//  ,  , ʰ  
+			stack.push_back({ nodeA.left, nodeA.left });
+			stack.push_back({ nodeA.right, nodeA.right });
+			stack.push_back({ nodeA.left, nodeA.right });
+		}
+
+		return;
+	}
+
+	if (!nodeA.aabb.Intersects(nodeB.aabb))
+	{
+		return;
+	}
+
+	if (nodeA.IsLeaf() && nodeB.IsLeaf())
+	{
+		for (std::uint32_t i = 0; i < nodeA.objectCount; ++i)
+		{
+			std::uint32_t slotA = m_objectIndices[nodeA.firstObject + i];
+
+			for (std::uint32_t j = 0; j < nodeB.objectCount; ++j)
+			{
+				std::uint32_t slotB = other.m_objectIndices[nodeB.firstObject + j];
+
+				if (m_objectAABBs[slotA].Intersects(other.m_objectAABBs[slotB]))
+				{
+					AddPair(outPairs, m_objectIDs[slotA], other.m_objectIDs[slotB], isSelf);
+				}
+			}
+		}
+
+		return;
+	}
+
+	//  ƴ  ߿  ū 带 
+	bool descendA = nodeB.IsLeaf() ||
+		(!nodeA.IsLeaf() && CalculateSurfaceArea(nodeA.aabb) > CalculateSurfaceArea(nodeB.aabb));
+
+	if (descendA)
+	{
+		stack.push_back({ nodeA.left, pair.b });
+		stack.push_back({ nodeA.right, pair.b });
+	}
+	else
+	{
+		stack.push_back({ pair.a, nodeB.left });
+		stack.push_back({ pair.a, nodeB.right });
+	}
+}
+
+float BVH::CalculateSurfaceArea(const DirectX::BoundingBox& box) const
+{
+	return 2.0f * (box.Extents.x * box.Extents.y + box.Extents.y * box.Extents.z + box.Extents.z * box.Extents.x);
+}
+
+void BVH::TryRotation(std::int32_t nodeIndex)
+{
+	if (nodeIndex == -1)
+	{
+		return;
+	}
+
+	BVHNode& parent = m_nodes[nodeIndex];
+	if (parent.IsLeaf())
+	{
+		return;
+	}
+
+	std::uint32_t left = parent.left;
+	std::uint32_t right = parent.right;
+
+	if (m_nodes[left].IsLeaf() && m_nodes[right].IsLeaf())
+	{
+		return;
+	}
+
+	float currentCost = CalculateSurfaceArea(m_nodes[left].aabb) + CalculateSurfaceArea(m_nodes[right].aabb);
+	float bestCost = currentCost;
+	int bestCase = 0;
+
+	auto CheckSwap = [&](std::uint32_t child, std::uint32_t grandChild1, std::uint32_t grandChild2, int caseIndex)
+		{
+			DirectX::BoundingBox merged;
+			DirectX::BoundingBox::CreateMerged(merged, m_nodes[child].aabb, m_nodes[grandChild2].aabb);
+			float cost = CalculateSurfaceArea(m_nodes[grandChild1].aabb) + CalculateSurfaceArea(merged);
+
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestCase = caseIndex;
+			}
+		};
+
+	// Case 1: L <-> RL, Case 2: L <-> RR
+	if (!m_nodes[right].IsLeaf())
+	{
+		CheckSwap(left, m_nodes[right].left, m_nodes[right].right, 1);
+		CheckSwap(left, m_nodes[right].right, m_nodes[right].left, 2);
+	}
+
+	// Case 3: R <-> LL, Case 4: R <-> LR
+	if (!m_nodes[left].IsLeaf())
+	{
+		CheckSwap(right, m_nodes[left].left, m_nodes[left].right, 3);
+		CheckSwap(right, m_nodes[left].right, m_nodes[left].left, 4);
+	}
+
+	if (bestCase != 0)
+	{
+		std::uint32_t* parentChildPtr = &parent.left;
+		std::uint32_t* otherPtr = &parent.right;
+
+		std::uint32_t uncle = left;
+		std::uint32_t sibling = right;
+
+		// Ī Ȳ̸  ݴ
+		if (bestCase >= 3)
+		{
+			std::swap(parentChildPtr, otherPtr);
+			std::swap(uncle, sibling);
+		}
+
+		BVHNode& siblingNode = m_nodes[sibling];
+
+		// ü  ī ĺ
+		bool isLeftNephew = (bestCase == 1 || bestCase == 3);
+		std::uint32_t nephew = isLeftNephew ? siblingNode.left : siblingNode.right;
+
+		//  
+		if (isLeftNephew)
+		{
+			siblingNode.left = uncle;
+		}
+		else
+		{
+			siblingNode.right = uncle;
+		}
+
+		m_nodes[uncle].parent = sibling;
+
+		// ī 
+		*parentChildPtr = nephew;
+		m_nodes[nephew].parent = nodeIndex;
+
+		// AABB 
+		DirectX::BoundingBox::CreateMerged(siblingNode.aabb, m_nodes[siblingNode.left].aabb, m_nodes[siblingNode.right].aabb);
+		DirectX::BoundingBox::CreateMerged(parent.aabb, m_nodes[parent.left].aabb, m_nodes[parent.right].aabb);
+	}
+}
+
+void BVH::RemoveLeaf(std::int32_t leafNodeIndex)
+{
+	if (leafNodeIndex == -1)
+	{
+		return;
+	}
+
+	std::int32_t parentIndex = m_nodes[leafNodeIndex].parent;
+	if (parentIndex == -1)
+	{
+		return;
+	}
+
+	std::int32_t grandParentIndex = m_nodes[parentIndex].parent;
+	std::int32_t siblingIndex = (m_nodes[parentIndex].left == leafNodeIndex) ? m_nodes[parentIndex].right : m_nodes[parentIndex].left;
+
+	m_nodes[siblingIndex].parent = grandParentIndex;
+
+	if (grandParentIndex != -1)
+	{
+		if (m_nodes[grandParentIndex].left == parentIndex)
+		{
+			m_nodes[grandParentIndex].left = siblingIndex;
+		}
+		else
+		{
+			m_nodes[grandParentIndex].right = siblingIndex;
+		}
+	}
+	else
+	{
+		m_rootIndex = siblingIndex;
+	}
+
+	m_freeNodeIndices.push_back(parentIndex);
+
+	std::int32_t curr = grandParentIndex;
+	while (curr != -1)
+	{
+		auto& node = m_nodes[curr];
+		DirectX::BoundingBox::CreateMerged(node.aabb, m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+		curr = node.parent;
+	}
+}
+
+void BVH::InsertLeaf(std::uint32_t leafNodeIndex)
+{
+	//  Ʈ  ٷ Ʈ
+	if (m_rootIndex == INVALID_INDEX)
+	{
+		m_nodes[leafNodeIndex].parent = -1;
+		m_rootIndex = leafNodeIndex;
+		return;
+	}
+
+	DirectX::BoundingBox leafBox = m_nodes[leafNodeIndex].aabb;
+	float leafArea = CalculateSurfaceArea(leafBox);
+
+	std::int32_t siblingIndex = m_rootIndex;
+
+	while (!m_nodes[siblingIndex].IsLeaf())
+	{
+		float area = CalculateSurfaceArea(m_nodes[siblingIndex].aabb);
+
+		DirectX::BoundingBox merged;
+		DirectX::BoundingBox::CreateMerged(merged, m_nodes[siblingIndex].aabb, leafBox);
+		float combinedArea = CalculateSurfaceArea(merged);
+
+		//  :  忡  vs ڽ 
+		float costDirectMerge = combinedArea;
+		float inheritanceCost = 2.0f * (combinedArea - area); // ޸ƽ
+
+		float costLeft, costRight;
+
+		// Left ڽ   
+		BoundingBox mergedLeft;
+		BoundingBox::CreateMerged(mergedLeft, m_nodes[m_nodes[siblingIndex].left].aabb, leafBox);
+		float pushLeftCost = CalculateSurfaceArea(mergedLeft) - CalculateSurfaceArea(m_nodes[m_nodes[siblingIndex].left].aabb);
+		costLeft = pushLeftCost + inheritanceCost;
+
+		// Right ڽ   
+		BoundingBox mergedRight;
+		BoundingBox::CreateMerged(mergedRight, m_nodes[m_nodes[siblingIndex].right].aabb, leafBox);
+		float pushRightCost = CalculateSurfaceArea(mergedRight) - CalculateSurfaceArea(m_nodes[m_nodes[siblingIndex].right].aabb);
+		costRight = pushRightCost + inheritanceCost;
+
+		//  忡 ϴ   θ 
+		if (costDirectMerge < costLeft && costDirectMerge < costRight)
+		{
+			break;
+		}
+
+		//    ̵
+		siblingIndex = (costLeft < costRight) ? m_nodes[siblingIndex].left : m_nodes[siblingIndex].right;
+	}
+
+	// ο θ  
+	std::int32_t oldParentIndex = m_nodes[siblingIndex].parent;
+	std::int32_t newParentIndex = AllocateNode();
+
+	//   
+	m_nodes[newParentIndex].parent = oldParentIndex;
+	m_nodes[newParentIndex].left = siblingIndex;
+	m_nodes[newParentIndex].right = leafNodeIndex;
+
+	// AABB 
+	BoundingBox::CreateMerged(m_nodes[newParentIndex].aabb, m_nodes[siblingIndex].aabb, leafBox);
+
+	m_nodes[siblingIndex].parent = newParentIndex;
+	m_nodes[leafNodeIndex].parent = newParentIndex;
+
+	//  θ(Ǵ Ʈ)  θ 
+	if (oldParentIndex != -1)
+	{
+		if (m_nodes[oldParentIndex].left == siblingIndex)
+		{
+			m_nodes[oldParentIndex].left = newParentIndex;
+		}
+		else
+		{
+			m_nodes[oldParentIndex].right = newParentIndex;
+		}
+	}
+	else
+	{
+		// Ʈ   ó (newParentIdx ο Ʈ )
+		m_rootIndex = newParentIndex;
+	}
+
+	// Ʈ Refit
+	std::int32_t curr = oldParentIndex;
+	while (curr != -1)
+	{
+		auto& node = m_nodes[curr];
+		BoundingBox::CreateMerged(node.aabb, m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+		curr = node.parent;
+	}
+}
+
+std::uint32_t BVH::AllocateNode()
+{
+	if (!m_freeNodeIndices.empty())
+	{
+		std::uint32_t index = m_freeNodeIndices.back();
+		m_freeNodeIndices.pop_back();
+
+		//     Ƿ ʱȭ
+		m_nodes[index] = {};
+		return index;
+	}
+
+	m_nodes.push_back({});
+	return static_cast<std::uint32_t>(m_nodes.size() - 1);
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <vector>
+#include <DirectXCollision.h>
+#include <cstdint>
+#include <utility>
+#include <functional>
+
+struct BVHNode
+{
+	DirectX::BoundingBox aabb;
+	std::int32_t parent = -1;
+	std::uint32_t left = 0;
+	std::uint32_t right = 0;
+	std::uint32_t firstObject = 0;
+	std::uint32_t objectCount = 0;
+
+	bool IsLeaf() const
+	{
+		return objectCount != 0;
+	}
+
+	bool IsRoot() const
+	{
+		return parent == -1;
+	}
+};
+
+// Ʈ ID ( << 22) | ڵ ε.
+//   밡 ö󰡹Ƿ  ID ٽ  IsValid ɷ
+class BVH
+{
+public:
+	static constexpr std::uint32_t INVALID_ID = UINT32_MAX;
+	static constexpr std::uint32_t INVALID_INDEX = UINT32_MAX;
+	static constexpr std::uint32_t HANDLE_INDEX_BITS = 22;
+	static constexpr std::uint32_t HANDLE_INDEX_MASK = (1u << HANDLE_INDEX_BITS) - 1;
+	// ÿ    ִ Ʈ . ѱ ε  Ʈ ħϹǷ Insert 
+	//  ε(HANDLE_INDEX_MASK)  . 밡 GENERATION_MASK  ID INVALID_ID 
+	static constexpr std::uint32_t MAX_HANDLE_COUNT = HANDLE_INDEX_MASK;
+	static constexpr std::uint32_t GENERATION_MASK = (1u << (32 - HANDLE_INDEX_BITS)) - 1;
+
+	// ġ Ʈ ID .  Ʈ ȿ ã  first < second
+	using ObjectPair = std::pair<std::uint32_t, std::uint32_t>;
+
+	// Raycast AABB  Ʈ   ˻. (Ʈ ID, ݱ   Ÿ) ޾Ƽ
+	// ׺   Ÿ ָ  ű پ,   
+	using RayHitTest = std::function<float(std::uint32_t id, float closest)>;
+
+private:
+	// ڵ ε -> Ʈ . Compact  Ű ID ״ 
+	struct ObjectHandle
+	{
+		std::uint32_t slot = INVALID_INDEX;
+		std::uint32_t generation = 0;
+		bool isMoved = false;
+	};
+
+	//  ϰ   .  Ʈ ȿ a == b   Ʈ γ ˻
+	struct NodePair
+	{
+		std::uint32_t a;
+		std::uint32_t b;
+	};
+
+private:
+	std::vector<BVHNode> m_nodes;
+	std::vector<std::uint32_t> m_objectIndices;
+	// Ʒ 迭 Ʈ  . Ʈ m_fatAABBs    m_objectAABBs 
+	std::vector<DirectX::BoundingBox> m_objectAABBs;
+	std::vector<DirectX::BoundingBox> m_fatAABBs;
+	std::vector<std::uint32_t> m_objectIDs;
+	std::vector<std::uint32_t> m_objectToLeafIndices;
+	std::vector<std::uint32_t> m_changedObjectIndices;
+	std::vector<ObjectHandle> m_handles;
+	// Insert ChangeAABB  ClearMovedObjects  Ʈ ID
+	std::vector<std::uint32_t> m_movedObjects;
+
+	//    ڸ ( Insert )
+	std::vector<std::uint32_t> m_freeNodeIndices;
+	std::vector<std::uint32_t> m_freeObjectSlots;
+	std::vector<std::uint32_t> m_freeObjectPositions;
+	std::vector<std::uint32_t> m_freeHandles;
+
+	std::uint32_t m_rootIndex = INVALID_INDEX;
+	std::uint32_t m_maxLeafSize = 1;
+	float m_fatMargin = 0.0f;
+	bool m_useFatAABBs = false;
+
+	// Refit  庰  ǥÿ ó  (Ź Ҵ ʵ )
+	std::vector<std::uint8_t> m_dirtyNodeFlags;
+	std::vector<std::uint32_t> m_dirtyNodes;
+
+public:
+	//  ִ Ʈ MAX_HANDLE_COUNT INVALID_ID
+	std::uint32_t Insert(const DirectX::BoundingBox& aabb);
+	//   ڸ  ƹ͵  ʰ  迭
+	std::vector<std::uint32_t> Insert(const std::vector<DirectX::BoundingBox>& aabbs);
+	// ̹  ID false
+	bool Remove(std::uint32_t id);
+	bool IsValid(std::uint32_t id) const;
+	// Ʈ  ʿϸ true. fat AABB  ̸  AABB fat AABB     ǰ,
+	// displacement(̹  ̵)    fat AABB  ø
+	bool ChangeAABB(std::uint32_t id, const DirectX::BoundingBox& newAABB,
+		const DirectX::XMFLOAT3& displacement = {});
+	void FullyRebuild(bool useSAH = true, bool useParallel = false);
+	void Refit();
+	void RefitWithRotation();
+	void OptimizeObject(std::uint32_t id);
+	//  ϳ  ִ Ʈ  (1~8).  FullyRebuild 
+	void SetMaxLeafSize(std::uint32_t maxLeafSize);
+	std::uint32_t GetMaxLeafSize() const;
+	// 0 ũ ׸ŭ Ű fat AABB Ʈ .  FullyRebuild 
+	void SetFatAABBMargin(float margin);
+	float GetFatAABBMargin() const;
+	bool UsesFatAABBs() const;
+	//     ȸ  带 ٽ ġ
+	void CompactNodes();
+	//  Ʈ    ڸ  ٽ ġ.    ĵ
+	void Compact();
+	const std::vector<BVHNode>& GetNodes() const;
+	const std::vector<std::uint32_t>& GetObjectIndices() const;
+	//   迭.   ID INVALID_ID
+	const std::vector<DirectX::BoundingBox>& GetObjectAABBs() const;
+	const std::vector<std::uint32_t>& GetObjectIDs() const;
+	// Ʈ  INVALID_INDEX
+	std::uint32_t GetRootIndex() const;
+
+	// ǰ ǥ. SAH  Ʈ ǥ ̶ Ʈ ũⰡ ޶   (  )
+	float CalculateSAHCost() const;
+	std::uint32_t CalculateMaxDepth() const;
+	//  ڸ    
+	std::uint32_t GetNodeCount() const;
+
+	//  Ʈ ID. outObjects   ä. ۸ ϸ   Ҵ 
+	void QueryFrustum(const DirectX::BoundingFrustum& frustum, std::vector<std::uint32_t>& outObjects) const;
+	void QueryAABB(const DirectX::BoundingBox& aabb, std::vector<std::uint32_t>& outObjects) const;
+	void QuerySphere(const DirectX::BoundingSphere& sphere, std::vector<std::uint32_t>& outObjects) const;
+	bool Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+		std::uint32_t& outObject, float& outDistance) const;
+	// AABB  hitTest    Ʈ ã (2ܰ BVH  Ʈ  )
+	bool Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+		const RayHitTest& hitTest, std::uint32_t& outObject, float& outDistance) const;
+
+	// N    ȸ ó (64   ȸ)
+	void QueryFrustums(const std::vector<DirectX::BoundingFrustum>& frustums, std::vector<std::vector<std::uint32_t>>& outObjects) const;
+
+	// AABB ġ Ʈ   ã (ε ).     
+	// movedOnly    ָ ã. useParallel̸ Ʈ κ  JobSystem ó
+	void FindOverlappingPairs(std::vector<ObjectPair>& outPairs, bool movedOnly = false, bool useParallel = false) const;
+	// first  Ʈ, second other Ʈ ID
+	void FindOverlappingPairs(const BVH& other, std::vector<ObjectPair>& outPairs, bool movedOnly = false, bool useParallel = false) const;
+	void ClearMovedObjects();
+
+private:
+	void BuildBVH(std::uint32_t begin, std::uint32_t end, std::uint32_t nodeIndex, bool useSAH, bool useParallel);
+	std::uint32_t SplitWithMedian(std::uint32_t begin, std::uint32_t end, const DirectX::XMFLOAT3& centerMin, const DirectX::XMFLOAT3& centerMax);
+	std::uint32_t SplitWithSAH(std::uint32_t begin, std::uint32_t end, const DirectX::XMFLOAT3& centerMin, const DirectX::XMFLOAT3& centerMax, float& outCost);
+	float CalculateSurfaceArea(const DirectX::BoundingBox& box) const;
+
+	void TryRotation(std::int32_t nodeIndex);
+
+	bool CanAllocateHandles(std::size_t count) const;
+	std::uint32_t AllocateObjectSlot(const DirectX::BoundingBox& aabb);
+	std::uint32_t GetSlot(std::uint32_t id) const;
+	// ٲ    ߺ    
+	void RefitChangedNodes(bool useRotation);
+	void RefitLeafAndAncestors(std::uint32_t leafIndex);
+	void SplitObjectFromLeaf(std::uint32_t slot);
+	void RemoveLeaf(std::int32_t leafNodeIndex);
+	void InsertLeaf(std::uint32_t leafNodeIndex);
+	std::uint32_t AllocateNode();
+
+	template<typename NodeTest, typename LeafVisit, typename RightFirst>
+	void Traverse(std::uint32_t startIndex, NodeTest& nodeTest, LeafVisit& leafVisit, RightFirst& rightFirst) const;
+	void CollectSubtree(std::uint32_t startIndex, std::vector<std::uint32_t>& outObjects) const;
+
+	void MarkMoved(std::uint32_t handleIndex);
+	void FindPairsWithDescent(const BVH& other, bool isSelf, std::vector<ObjectPair>& outPairs, bool useParallel) const;
+	void FindPairsWithMovedObjects(const BVH& other, bool isSelf, std::vector<ObjectPair>& outPairs, bool useParallel) const;
+	//   ϳ ó:  Ʈ  ϰ, ƴϸ ġ ڽ  stack 
+	void ExpandNodePair(const BVH& other, bool isSelf, const NodePair& pair, std::vector<NodePair>& stack, std::vector<ObjectPair>& outPairs) const;
+	// aabb ġ  Ʈ Ʈ ã visit(objectSlot) 
+	template<typename Visit>
+	void VisitOverlaps(const DirectX::BoundingBox& aabb, Visit& visit) const;
+};
\ No newline at end of file
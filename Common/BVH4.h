@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <cfloat>
+#include <DirectXMath.h>
+
+// ڽ 4 min/max ະ Ƶ  (128Ʈ, ĳö 2). FlatBVH MeshBVH  ġ 
+// count 0̸ child   ε, 0 ũ child count (Ʈ, ﰢ)  
+//  ʴ  min > max ڽ  ׽Ʈ  
+struct alignas(64) BVH4Node
+{
+	float minX[4];
+	float minY[4];
+	float minZ[4];
+	float maxX[4];
+	float maxY[4];
+	float maxZ[4];
+	std::uint32_t child[4];
+	std::uint32_t count[4];
+};
+
+// BVH4Node  ȸ    Լ
+namespace BVH4
+{
+	constexpr std::uint32_t WIDTH = 4;
+	constexpr std::uint32_t EMPTY_LANE = UINT32_MAX;
+
+	//  ϳ  4 ະ ͷ  
+	struct Lanes
+	{
+		DirectX::XMVECTOR minX;
+		DirectX::XMVECTOR minY;
+		DirectX::XMVECTOR minZ;
+		DirectX::XMVECTOR maxX;
+		DirectX::XMVECTOR maxY;
+		DirectX::XMVECTOR maxZ;
+	};
+
+	// SAH ҿ 
+	struct Bin
+	{
+		DirectX::XMFLOAT3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+		DirectX::XMFLOAT3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		std::uint32_t count = 0;
+	};
+
+	inline Lanes LoadLanes(const BVH4Node& node)
+	{
+		using DirectX::XMFLOAT4A;
+
+		return {
+			DirectX::XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(node.minX)),
+			DirectX::XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(node.minY)),
+			DirectX::XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(node.minZ)),
+			DirectX::XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(node.maxX)),
+			DirectX::XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(node.maxY)),
+			DirectX::XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(node.maxZ))
+		};
+	}
+
+	//      Ʈ ϳ
+	inline std::uint32_t LaneMask(DirectX::FXMVECTOR v)
+	{
+#if defined(_XM_SSE_INTRINSICS_)
+		return static_cast<std::uint32_t>(_mm_movemask_ps(v));
+#else
+		std::uint32_t lanes[4];
+		DirectX::XMStoreInt4(lanes, v);
+
+		return (lanes[0] >> 31) | ((lanes[1] >> 31) << 1) | ((lanes[2] >> 31) << 2) | ((lanes[3] >> 31) << 3);
+#endif
+	}
+
+	inline int FirstLane(std::uint32_t mask)
+	{
+		return (mask & 1) ? 0 : (mask & 2) ? 1 : (mask & 4) ? 2 : 3;
+	}
+
+	inline bool IsEmptyLane(const BVH4Node& node, std::uint32_t lane)
+	{
+		return node.child[lane] == EMPTY_LANE;
+	}
+
+	//    ׽Ʈ  ϴ ڽ ä
+	inline void ClearLane(BVH4Node& node, std::uint32_t lane)
+	{
+		node.minX[lane] = node.minY[lane] = node.minZ[lane] = FLT_MAX;
+		node.maxX[lane] = node.maxY[lane] = node.maxZ[lane] = -FLT_MAX;
+		node.child[lane] = EMPTY_LANE;
+		node.count[lane] = 0;
+	}
+
+	inline float GetAxis(const DirectX::XMFLOAT3& v, int axis)
+	{
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	inline float HalfSurfaceArea(const DirectX::XMFLOAT3& min, const DirectX::XMFLOAT3& max)
+	{
+		float dx = max.x - min.x;
+		float dy = max.y - min.y;
+		float dz = max.z - min.z;
+
+		return dx * dy + dy * dz + dz * dx;
+	}
+}
@@ -0,0 +1,210 @@
+#include "BakedAnimationData.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Helper.h"
+#include "AnimationData.h"
+#include "AnimationPose.h"
+#include "SkeletalMeshData.h"
+
+void BakedAnimationData::Create(const SkeletonData& skeletonData, const AnimationData& animationData,
+	const std::vector<SkeletalMeshSection>& meshSections, float framesPerSecond)
+{
+	m_framesPerSecond = framesPerSecond;
+
+	std::vector<Bone> skeleton;
+	skeletonData.SetupSkeletonInstance(skeleton);
+	m_boneCount = static_cast<std::uint32_t>(std::min(skeleton.size(), MAX_BONE_NUM));
+
+	const auto& animations = animationData.GetAnimations();
+
+	//   duration ġ ݺ    ã ʾƵ 
+	std::uint32_t totalFrameCount = 0;
+	m_clips.clear();
+	m_clips.reserve(animations.size());
+	for (const auto& animation : animations)
+	{
+		BakedAnimationClip clip{};
+		clip.firstFrame = totalFrameCount;
+		clip.frameCount = animation.duration > 0.0f ? static_cast<std::uint32_t>(std::ceil(animation.duration * m_framesPerSecond)) + 1 : 1;
+		clip.duration = animation.duration;
+
+		totalFrameCount += clip.frameCount;
+		m_clips.push_back(clip);
+	}
+
+	m_texels.assign(static_cast<size_t>(GetWidth()) * totalFrameCount, DirectX::XMFLOAT4{ 0.0f, 0.0f, 0.0f, 0.0f });
+
+	m_sectionCount = static_cast<std::uint32_t>(meshSections.size());
+	m_sectionBounds.assign(static_cast<size_t>(m_sectionCount) * totalFrameCount, DirectX::BoundingBox());
+
+	PoseBuffer bindPose;
+	PoseBuffer pose;
+	AnimationPose::SetupBindPose(skeleton, bindPose);
+	std::vector<LastKeyIndex> cursors;
+	std::vector<DirectX::XMFLOAT4X4> models(skeleton.size());
+
+	for (size_t i = 0; i < animations.size(); ++i)
+	{
+		const Animation& animation = animations[i];
+		const BakedAnimationClip& clip = m_clips[i];
+
+		cursors.clear();
+
+		for (std::uint32_t frame = 0; frame < clip.frameCount; ++frame)
+		{
+			const float time = std::min(frame / m_framesPerSecond, animation.duration);
+			AnimationPose::Sample(animation, time, bindPose, cursors, pose);
+
+			DirectX::XMFLOAT4* row = m_texels.data() + static_cast<size_t>(clip.firstFrame + frame) * GetWidth();
+
+			// θ ڽĺ տ ִ 
+			for (const auto& bone : skeleton)
+			{
+				const DirectX::XMMATRIX local = DirectX::XMMatrixAffineTransformation(
+					DirectX::XMLoadFloat3(&pose.scales[bone.index]), DirectX::XMVectorZero(),
+					DirectX::XMLoadFloat4(&pose.rotations[bone.index]), DirectX::XMLoadFloat3(&pose.translations[bone.index]));
+
+				DirectX::XMMATRIX model = local;
+				if (bone.parentIndex != -1)
+				{
+					model = DirectX::XMMatrixMultiply(local, DirectX::XMLoadFloat4x4(&models[bone.parentIndex]));
+				}
+				DirectX::XMStoreFloat4x4(&models[bone.index], model);
+
+				if (bone.index >= m_boneCount)
+				{
+					continue;
+				}
+
+				const DirectX::XMMATRIX transposed = DirectX::XMMatrixTranspose(model);
+				DirectX::XMFLOAT4* texel = row + static_cast<size_t>(bone.index) * TEXELS_PER_BONE;
+				DirectX::XMStoreFloat4(&texel[0], transposed.r[0]);
+				DirectX::XMStoreFloat4(&texel[1], transposed.r[1]);
+				DirectX::XMStoreFloat4(&texel[2], transposed.r[2]);
+			}
+
+			// SkeletalMesh::CalculateWorldBounds  
+			DirectX::BoundingBox* rowBounds = m_sectionBounds.data() + static_cast<size_t>(clip.firstFrame + frame) * m_sectionCount;
+
+			for (std::uint32_t section = 0; section < m_sectionCount; ++section)
+			{
+				const auto& boneBoundsList = meshSections[section].boneBounds;
+				rowBounds[section] = DirectX::BoundingBox(DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f), DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f));
+
+				for (size_t j = 0; j < boneBoundsList.size(); ++j)
+				{
+					DirectX::BoundingBox bounds;
+					boneBoundsList[j].bounds.Transform(bounds, DirectX::XMLoadFloat4x4(&models[boneBoundsList[j].boneIndex]));
+
+					if (j == 0)
+					{
+						rowBounds[section] = bounds;
+					}
+					else
+					{
+						DirectX::BoundingBox::CreateMerged(rowBounds[section], rowBounds[section], bounds);
+					}
+				}
+			}
+		}
+	}
+
+	Log("Baked animation: ", m_clips.size(), " clips, ", GetWidth(), " x ", GetHeight(), " texels (",
+		m_texels.size() * sizeof(DirectX::XMFLOAT4), " bytes) at ", m_framesPerSecond, " fps");
+}
+
+std::uint32_t BakedAnimationData::GetWidth() const
+{
+	return m_boneCount * TEXELS_PER_BONE;
+}
+
+std::uint32_t BakedAnimationData::GetHeight() const
+{
+	return m_clips.empty() ? 0 : m_clips.back().firstFrame + m_clips.back().frameCount;
+}
+
+std::uint32_t BakedAnimationData::GetBoneCount() const
+{
+	return m_boneCount;
+}
+
+std::uint32_t BakedAnimationData::GetSectionCount() const
+{
+	return m_sectionCount;
+}
+
+float BakedAnimationData::GetFramesPerSecond() const
+{
+	return m_framesPerSecond;
+}
+
+const std::vector<BakedAnimationClip>& BakedAnimationData::GetClips() const
+{
+	return m_clips;
+}
+
+const std::vector<DirectX::XMFLOAT4>& BakedAnimationData::GetTexels() const
+{
+	return m_texels;
+}
+
+BakedAnimationFrame BakedAnimationData::FindFrame(size_t clipIndex, float time) const
+{
+	const BakedAnimationClip& clip = m_clips[clipIndex];
+
+	const float clampedTime = std::clamp(time, 0.0f, clip.duration);
+	const std::uint32_t frame0 = std::min(static_cast<std::uint32_t>(clampedTime * m_framesPerSecond), clip.frameCount - 1);
+	const std::uint32_t frame1 = std::min(frame0 + 1, clip.frameCount - 1);
+
+	//   duration ġ   1 / fps ª  .   ð  
+	const float time0 = frame0 / m_framesPerSecond;
+	const float time1 = std::min(frame1 / m_framesPerSecond, clip.duration);
+
+	BakedAnimationFrame result{};
+	result.row0 = clip.firstFrame + frame0;
+	result.row1 = clip.firstFrame + frame1;
+	result.lerp = time1 > time0 ? std::clamp((clampedTime - time0) / (time1 - time0), 0.0f, 1.0f) : 0.0f;
+
+	return result;
+}
+
+void BakedAnimationData::SamplePalette(const BakedAnimationFrame& frame, BoneMatrixArray& out) const
+{
+	const DirectX::XMFLOAT4* row0 = m_texels.data() + static_cast<size_t>(frame.row0) * GetWidth();
+	const DirectX::XMFLOAT4* row1 = m_texels.data() + static_cast<size_t>(frame.row1) * GetWidth();
+
+	for (std::uint32_t bone = 0; bone < m_boneCount; ++bone)
+	{
+		DirectX::XMMATRIX pose;
+		for (std::uint32_t i = 0; i < TEXELS_PER_BONE; ++i)
+		{
+			const size_t texel = static_cast<size_t>(bone) * TEXELS_PER_BONE + i;
+			pose.r[i] = DirectX::XMVectorLerp(DirectX::XMLoadFloat4(&row0[texel]), DirectX::XMLoadFloat4(&row1[texel]), frame.lerp);
+		}
+		pose.r[3] = DirectX::g_XMIdentityR3;
+
+		DirectX::XMStoreFloat4x4(&out[bone], pose);
+	}
+}
+
+void BakedAnimationData::CalculateSectionBounds(const BakedAnimationFrame& frame, const DirectX::SimpleMath::Matrix& world,
+	std::vector<DirectX::BoundingBox>& outSectionBounds) const
+{
+	const DirectX::BoundingBox* row0 = m_sectionBounds.data() + static_cast<size_t>(frame.row0) * m_sectionCount;
+	const DirectX::BoundingBox* row1 = m_sectionBounds.data() + static_cast<size_t>(frame.row1) * m_sectionCount;
+
+	outSectionBounds.resize(m_sectionCount);
+
+	for (std::uint32_t section = 0; section < m_sectionCount; ++section)
+	{
+		DirectX::BoundingBox merged = row0[section];
+		if (frame.row1 != frame.row0)
+		{
+			DirectX::BoundingBox::CreateMerged(merged, merged, row1[section]);
+		}
+
+		merged.Transform(outSectionBounds[section], world);
+	}
+}
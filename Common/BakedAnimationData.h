@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <directxtk/SimpleMath.h>
+#include <DirectXCollision.h>
+
+#include "AssetData.h"
+#include "SkeletonData.h"
+
+class AnimationData;
+struct SkeletalMeshSection;
+
+// Ŭ ϳ ȷƮ ؽó ϴ  
+struct BakedAnimationClip
+{
+	std::uint32_t firstFrame;
+	std::uint32_t frameCount;
+	float duration;
+};
+
+//  ð ȷƮ ؽó      ٲ . ̴  ״ ѱ
+struct BakedAnimationFrame
+{
+	std::uint32_t row0;
+	std::uint32_t row1;
+	float lerp;
+};
+
+//  Ŭ  ӷƮ ̸ ø  ȷƮ.  ϳ  ̰
+//  ϳ ؼ  (ġ   0 ~ 2, 3 ׻ (0, 0, 0, 1))
+// νϽ Ŭ ð   ǹǷ CPU  򰡿 ȷƮ ε尡 .
+// ø Ӹ ̸   AABB ؼ CPU ȷƮ  
+class BakedAnimationData :
+	public AssetData
+{
+public:
+	static constexpr std::uint32_t TEXELS_PER_BONE = 3;
+
+private:
+	std::vector<BakedAnimationClip> m_clips;
+	// GetWidth() * GetHeight().  켱
+	std::vector<DirectX::XMFLOAT4> m_texels;
+	std::uint32_t m_boneCount = 0;
+	float m_framesPerSecond = 30.0f;
+	// ึ  ŭ.   AABB
+	std::vector<DirectX::BoundingBox> m_sectionBounds;
+	std::uint32_t m_sectionCount = 0;
+
+public:
+	// meshSections Ű .  AABB   Ű ģ   AABB 
+	void Create(const SkeletonData& skeletonData, const AnimationData& animationData,
+		const std::vector<SkeletalMeshSection>& meshSections, float framesPerSecond = 30.0f);
+
+public:
+	std::uint32_t GetWidth() const;
+	std::uint32_t GetHeight() const;
+	std::uint32_t GetBoneCount() const;
+	std::uint32_t GetSectionCount() const;
+	float GetFramesPerSecond() const;
+	const std::vector<BakedAnimationClip>& GetClips() const;
+	const std::vector<DirectX::XMFLOAT4>& GetTexels() const;
+
+	// Ŭ ̷ ڸ time    ̷ ٲ
+	BakedAnimationFrame FindFrame(size_t clipIndex, float time) const;
+	// ̴      ȷƮ. SkeletalMesh ȷƮ  ġ ġ
+	void SamplePalette(const BakedAnimationFrame& frame, BoneMatrixArray& out) const;
+	//   ̸     AABB ģ  ȿ Ƿ   world Ű   ä
+	void CalculateSectionBounds(const BakedAnimationFrame& frame, const DirectX::SimpleMath::Matrix& world,
+		std::vector<DirectX::BoundingBox>& outSectionBounds) const;
+};
@@ -13,6 +13,7 @@
 #include "DepthStencilView.h"
 #include "DepthStencilState.h"
 #include "RasterizerState.h"
+#include "SkinningPaletteBuffer.h"
 
 D3DResourceManager& D3DResourceManager::Get()
 {
@@ -348,4 +349,22 @@ std::shared_ptr<RasterizerState> D3DResourceManager::GetOrCreateRasterizerState(
 	m_rasterizerStates[name] = rasterizerState;
 
 	return rasterizerState;
+}
+
+std::shared_ptr<SkinningPaletteBuffer> D3DResourceManager::GetOrCreateSkinningPaletteBuffer(const std::wstring& name, UINT capacity)
+{
+	if (auto find = m_skinningPaletteBuffers.find(name); find != m_skinningPaletteBuffers.end())
+	{
+		if (!find->second.expired())
+		{
+			return find->second.lock();
+		}
+	}
+
+	std::shared_ptr<SkinningPaletteBuffer> skinningPaletteBuffer = std::make_shared<SkinningPaletteBuffer>();
+	skinningPaletteBuffer->Create(m_graphicsDevice->GetDevice(), capacity);
+
+	m_skinningPaletteBuffers[name] = skinningPaletteBuffer;
+
+	return skinningPaletteBuffer;
 }
\ No newline at end of file
@@ -21,6 +21,7 @@ class Texture2D;
 class DepthStencilView;
 class DepthStencilState;
 class RasterizerState;
+class SkinningPaletteBuffer;
 
 class GraphicsDevice;
 
@@ -41,6 +42,7 @@ private:
 	std::unordered_map<std::wstring, std::weak_ptr<DepthStencilView>> m_depthStencilViews;
 	std::unordered_map<std::wstring, std::weak_ptr<DepthStencilState>> m_depthStencilStates;
 	std::unordered_map<std::wstring, std::weak_ptr<RasterizerState>> m_rasterizerStates;
+	std::unordered_map<std::wstring, std::weak_ptr<SkinningPaletteBuffer>> m_skinningPaletteBuffers;
 
 	const GraphicsDevice* m_graphicsDevice = nullptr;
 
@@ -77,4 +79,6 @@ public:
 		const D3D11_DEPTH_STENCIL_VIEW_DESC& dsvDesc);
 	std::shared_ptr<DepthStencilState> GetOrCreateDepthStencilState(const std::wstring& name, const D3D11_DEPTH_STENCIL_DESC& dsDesc);
 	std::shared_ptr<RasterizerState> GetOrCreateRasterizerState(const std::wstring& name, const D3D11_RASTERIZER_DESC& rsDesc);
+	// capacity ó    . ڶ Map Ű
+	std::shared_ptr<SkinningPaletteBuffer> GetOrCreateSkinningPaletteBuffer(const std::wstring& name, UINT capacity);
 };
\ No newline at end of file
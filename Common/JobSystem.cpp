@@ -0,0 +1,219 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace
+{
+	//  尡 ϴ ť (Ŀ ƴϸ 0)
+	thread_local std::uint32_t t_queueIndex = 0;
+
+	struct JobCompletion
+	{
+		JobSystem::Counter& counter;
+
+		~JobCompletion()
+		{
+			counter.pending.fetch_sub(1, std::memory_order_release);
+		}
+	};
+}
+
+JobSystem::JobSystem()
+{
+	std::uint32_t workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+	m_queues.reserve(workerCount + 1);
+	for (std::uint32_t i = 0; i < workerCount + 1; ++i)
+	{
+		m_queues.push_back(std::make_unique<JobQueue>());
+	}
+
+	m_isRunning = true;
+
+	m_workers.reserve(workerCount);
+	for (std::uint32_t i = 0; i < workerCount; ++i)
+	{
+		m_workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_isRunning = false;
+	}
+
+	m_sleepCondition.notify_all();
+
+	for (auto& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+JobSystem& JobSystem::Get()
+{
+	static JobSystem s_instance;
+
+	return s_instance;
+}
+
+void JobSystem::Dispatch(Counter& counter, Job job)
+{
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+	// ۾  ī 
+	Job wrapped = [&counter, job = std::move(job)]()
+		{
+			JobCompletion completion{ counter };
+			job();
+		};
+
+	// Ŀ  ٷ 
+	if (m_workers.empty())
+	{
+		wrapped();
+		return;
+	}
+
+	{
+		auto& queue = *m_queues[t_queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(std::move(wrapped));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_queuedJobCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	m_sleepCondition.notify_one();
+}
+
+void JobSystem::Wait(Counter& counter)
+{
+	while (counter.pending.load(std::memory_order_acquire) != 0)
+	{
+		if (!TryRunJob(t_queueIndex))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::ParallelFor(std::uint32_t count, std::uint32_t batchSize, const RangeJob& job)
+{
+	batchSize = std::max(1u, batchSize);
+
+	//  ʿ䰡  ȣ 忡 ٷ 
+	if (m_workers.empty() || count <= batchSize)
+	{
+		if (count > 0)
+		{
+			job(0, count);
+		}
+
+		return;
+	}
+
+	Counter counter;
+
+	for (std::uint32_t begin = 0; begin < count; begin += batchSize)
+	{
+		const std::uint32_t end = std::min(count, begin + batchSize);
+
+		Dispatch(counter, [&job, begin, end]()
+			{
+				job(begin, end);
+			});
+	}
+
+	Wait(counter);
+}
+
+std::uint32_t JobSystem::GetWorkerCount() const
+{
+	return static_cast<std::uint32_t>(m_workers.size());
+}
+
+void JobSystem::WorkerLoop(std::uint32_t queueIndex)
+{
+	t_queueIndex = queueIndex;
+
+	while (true)
+	{
+		if (TryRunJob(queueIndex))
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_sleepCondition.wait(lock, [this]()
+			{
+				return !m_isRunning || m_queuedJobCount.load(std::memory_order_relaxed) != 0;
+			});
+
+		if (!m_isRunning)
+		{
+			return;
+		}
+	}
+}
+
+bool JobSystem::TryRunJob(std::uint32_t queueIndex)
+{
+	Job job;
+
+	if (!TryPop(queueIndex, job) && !TrySteal(queueIndex, job))
+	{
+		return false;
+	}
+
+	m_queuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+
+	job();
+
+	return true;
+}
+
+bool JobSystem::TryPop(std::uint32_t queueIndex, Job& outJob)
+{
+	auto& queue = *m_queues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+
+	if (queue.jobs.empty())
+	{
+		return false;
+	}
+
+	// ڱ ť ֱٿ  ۾ (ĳÿ  Ȯ )
+	outJob = std::move(queue.jobs.back());
+	queue.jobs.pop_back();
+
+	return true;
+}
+
+bool JobSystem::TrySteal(std::uint32_t queueIndex, Job& outJob)
+{
+	std::uint32_t queueCount = static_cast<std::uint32_t>(m_queues.size());
+
+	for (std::uint32_t i = 1; i < queueCount; ++i)
+	{
+		auto& queue = *m_queues[(queueIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (queue.jobs.empty())
+		{
+			continue;
+		}
+
+		//  ť  ۾ (fork-join  ū ۾)
+		outJob = std::move(queue.jobs.front());
+		queue.jobs.pop_front();
+
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstdint>
+
+// Ŀ 帶 ť ΰ, ڱ ť  ٸ ť Ŀ ۾ Ǯ
+// ۾ ȿ ٽ Dispatch/Wait ϴ fork-join · 
+class JobSystem
+{
+public:
+	// ParallelFor ׸ ϳ ſ (ִϸ̼ νϽ )   ũ. ̺ ߰  й   ŭ
+	static constexpr std::uint32_t DEFAULT_BATCH_SIZE = 4;
+
+	using Job = std::function<void()>;
+	// [begin, end)  óϴ ۾
+	using RangeJob = std::function<void(std::uint32_t begin, std::uint32_t end)>;
+
+	// Dispatch ۾ ϷḦ ٸ  ī
+	struct Counter
+	{
+		std::atomic<std::uint32_t> pending{ 0 };
+	};
+
+private:
+	struct JobQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	// 0 ť Ŀ ƴ (  ) 
+	std::vector<std::unique_ptr<JobQueue>> m_queues;
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCondition;
+	std::atomic<std::uint32_t> m_queuedJobCount{ 0 };
+	std::atomic<bool> m_isRunning{ false };
+
+private:
+	JobSystem();
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+	JobSystem(JobSystem&&) = delete;
+	JobSystem& operator=(JobSystem&&) = delete;
+
+public:
+	static JobSystem& Get();
+
+public:
+	void Dispatch(Counter& counter, Job job);
+	// ٸ    ۾  
+	void Wait(Counter& counter);
+	// [0, count) batchSize  ۾     ٸ
+	void ParallelFor(std::uint32_t count, std::uint32_t batchSize, const RangeJob& job);
+
+	std::uint32_t GetWorkerCount() const;
+
+private:
+	void WorkerLoop(std::uint32_t queueIndex);
+	bool TryRunJob(std::uint32_t queueIndex);
+	bool TryPop(std::uint32_t queueIndex, Job& outJob);
+	bool TrySteal(std::uint32_t queueIndex, Job& outJob);
+};
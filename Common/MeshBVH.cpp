@@ -0,0 +1,827 @@
+#include "MeshBVH.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "StaticMeshData.h"
+
+using DirectX::XMFLOAT3;
+using DirectX::XMVECTOR;
+using DirectX::FXMVECTOR;
+using BVH4::Bin;
+using BVH4::Lanes;
+using BVH4::LoadLanes;
+using BVH4::LaneMask;
+using BVH4::GetAxis;
+using BVH4::HalfSurfaceArea;
+
+namespace
+{
+	constexpr std::uint32_t BIN_COUNT = 16;
+	//    ﰢ    
+	constexpr float DETERMINANT_EPSILON = 1e-12f;
+	//  ϳ   ִ WIDTH - 1 þǷ  * (WIDTH - 1) + 1̸ 
+	constexpr std::uint32_t STACK_SIZE = MeshBVH::MAX_DEPTH * (MeshBVH::WIDTH - 1) + 1;
+
+	struct BuildTriangle
+	{
+		XMFLOAT3 min;
+		XMFLOAT3 max;
+		XMFLOAT3 centroid;
+	};
+
+	//     ӽ  Ʈ
+	struct BuildNode
+	{
+		XMFLOAT3 min;
+		XMFLOAT3 max;
+		std::uint32_t left = 0;
+		std::uint32_t right = 0;
+		std::uint32_t first = 0;
+		std::uint32_t count = 0;
+
+		bool IsLeaf() const
+		{
+			return count != 0;
+		}
+	};
+
+	void Grow(XMFLOAT3& min, XMFLOAT3& max, const XMFLOAT3& otherMin, const XMFLOAT3& otherMax)
+	{
+		min = { std::min(min.x, otherMin.x), std::min(min.y, otherMin.y), std::min(min.z, otherMin.z) };
+		max = { std::max(max.x, otherMax.x), std::max(max.y, otherMax.y), std::max(max.z, otherMax.z) };
+	}
+
+	XMFLOAT3 Subtract(const XMFLOAT3& a, const XMFLOAT3& b)
+	{
+		return { a.x - b.x, a.y - b.y, a.z - b.z };
+	}
+
+	XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b)
+	{
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	float Dot(const XMFLOAT3& a, const XMFLOAT3& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	// [begin, end) binned SAH  ġ.    begin ȯ
+	std::uint32_t SplitWithSAH(std::vector<std::uint32_t>& order, const std::vector<BuildTriangle>& triangles,
+		std::uint32_t begin, std::uint32_t end, const XMFLOAT3& centroidMin, const XMFLOAT3& centroidMax)
+	{
+		float bestCost = FLT_MAX;
+		int bestAxis = -1;
+		std::uint32_t bestSplit = 0;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float axisMin = GetAxis(centroidMin, axis);
+			float extent = GetAxis(centroidMax, axis) - axisMin;
+
+			if (extent <= 0.0f)
+			{
+				continue;
+			}
+
+			Bin bins[BIN_COUNT];
+			float scale = BIN_COUNT / extent;
+
+			for (std::uint32_t i = begin; i < end; ++i)
+			{
+				const auto& triangle = triangles[order[i]];
+				std::uint32_t binIndex = std::min(BIN_COUNT - 1, static_cast<std::uint32_t>((GetAxis(triangle.centroid, axis) - axisMin) * scale));
+
+				Grow(bins[binIndex].min, bins[binIndex].max, triangle.min, triangle.max);
+				++bins[binIndex].count;
+			}
+
+			// ʺ  /  ΰ  ϸ鼭 
+			float rightAreas[BIN_COUNT];
+			std::uint32_t rightCounts[BIN_COUNT];
+			Bin right;
+
+			for (std::uint32_t i = BIN_COUNT - 1; i > 0; --i)
+			{
+				Grow(right.min, right.max, bins[i].min, bins[i].max);
+				right.count += bins[i].count;
+
+				rightAreas[i] = right.count > 0 ? HalfSurfaceArea(right.min, right.max) : 0.0f;
+				rightCounts[i] = right.count;
+			}
+
+			Bin left;
+
+			for (std::uint32_t i = 0; i < BIN_COUNT - 1; ++i)
+			{
+				Grow(left.min, left.max, bins[i].min, bins[i].max);
+				left.count += bins[i].count;
+
+				if (left.count == 0 || rightCounts[i + 1] == 0)
+				{
+					continue;
+				}
+
+				float cost = HalfSurfaceArea(left.min, left.max) * left.count + rightAreas[i + 1] * rightCounts[i + 1];
+
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = i + 1;
+				}
+			}
+		}
+
+		if (bestAxis == -1)
+		{
+			return begin;
+		}
+
+		float axisMin = GetAxis(centroidMin, bestAxis);
+		float scale = BIN_COUNT / (GetAxis(centroidMax, bestAxis) - axisMin);
+
+		auto middle = std::partition(order.begin() + begin, order.begin() + end,
+			[&](std::uint32_t index)
+			{
+				std::uint32_t binIndex = std::min(BIN_COUNT - 1, static_cast<std::uint32_t>((GetAxis(triangles[index].centroid, bestAxis) - axisMin) * scale));
+				return binIndex < bestSplit;
+			});
+
+		return static_cast<std::uint32_t>(middle - order.begin());
+	}
+
+	bool IntersectTriangle(const MeshBVHTriangle& triangle, const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance,
+		float& outDistance, float& outU, float& outV)
+	{
+		XMFLOAT3 p = Cross(direction, triangle.edge2);
+		float determinant = Dot(triangle.edge1, p);
+
+		if (std::fabs(determinant) < DETERMINANT_EPSILON)
+		{
+			return false;
+		}
+
+		float invDeterminant = 1.0f / determinant;
+		XMFLOAT3 toOrigin = Subtract(origin, triangle.v0);
+
+		float u = Dot(toOrigin, p) * invDeterminant;
+		if (u < 0.0f || u > 1.0f)
+		{
+			return false;
+		}
+
+		XMFLOAT3 q = Cross(toOrigin, triangle.edge1);
+
+		float v = Dot(direction, q) * invDeterminant;
+		if (v < 0.0f || u + v > 1.0f)
+		{
+			return false;
+		}
+
+		float distance = Dot(triangle.edge2, q) * invDeterminant;
+		if (distance < 0.0f || distance > maxDistance)
+		{
+			return false;
+		}
+
+		outDistance = distance;
+		outU = u;
+		outV = v;
+
+		return true;
+	}
+
+	// 4  ະ ͷ Ƶ 
+	struct PacketLanes
+	{
+		XMVECTOR originX;
+		XMVECTOR originY;
+		XMVECTOR originZ;
+		XMVECTOR directionX;
+		XMVECTOR directionY;
+		XMVECTOR directionZ;
+		XMVECTOR invX;
+		XMVECTOR invY;
+		XMVECTOR invZ;
+	};
+
+	// ﰢ ϳ  4 ÿ ˻. closest   ũ 
+	std::uint32_t IntersectTrianglePacket(const MeshBVHTriangle& triangle, const PacketLanes& rays, FXMVECTOR closest,
+		XMVECTOR& outDistance, XMVECTOR& outU, XMVECTOR& outV)
+	{
+		using namespace DirectX;
+
+		XMVECTOR e1x = XMVectorReplicate(triangle.edge1.x);
+		XMVECTOR e1y = XMVectorReplicate(triangle.edge1.y);
+		XMVECTOR e1z = XMVectorReplicate(triangle.edge1.z);
+		XMVECTOR e2x = XMVectorReplicate(triangle.edge2.x);
+		XMVECTOR e2y = XMVectorReplicate(triangle.edge2.y);
+		XMVECTOR e2z = XMVectorReplicate(triangle.edge2.z);
+
+		// p = direction x edge2
+		XMVECTOR px = XMVectorSubtract(XMVectorMultiply(rays.directionY, e2z), XMVectorMultiply(rays.directionZ, e2y));
+		XMVECTOR py = XMVectorSubtract(XMVectorMultiply(rays.directionZ, e2x), XMVectorMultiply(rays.directionX, e2z));
+		XMVECTOR pz = XMVectorSubtract(XMVectorMultiply(rays.directionX, e2y), XMVectorMultiply(rays.directionY, e2x));
+
+		XMVECTOR determinant = XMVectorMultiplyAdd(e1x, px, XMVectorMultiplyAdd(e1y, py, XMVectorMultiply(e1z, pz)));
+		XMVECTOR valid = XMVectorGreater(XMVectorAbs(determinant), XMVectorReplicate(DETERMINANT_EPSILON));
+		XMVECTOR invDeterminant = XMVectorReciprocal(determinant);
+
+		XMVECTOR tx = XMVectorSubtract(rays.originX, XMVectorReplicate(triangle.v0.x));
+		XMVECTOR ty = XMVectorSubtract(rays.originY, XMVectorReplicate(triangle.v0.y));
+		XMVECTOR tz = XMVectorSubtract(rays.originZ, XMVectorReplicate(triangle.v0.z));
+
+		XMVECTOR u = XMVectorMultiply(XMVectorMultiplyAdd(tx, px, XMVectorMultiplyAdd(ty, py, XMVectorMultiply(tz, pz))), invDeterminant);
+
+		// q = toOrigin x edge1
+		XMVECTOR qx = XMVectorSubtract(XMVectorMultiply(ty, e1z), XMVectorMultiply(tz, e1y));
+		XMVECTOR qy = XMVectorSubtract(XMVectorMultiply(tz, e1x), XMVectorMultiply(tx, e1z));
+		XMVECTOR qz = XMVectorSubtract(XMVectorMultiply(tx, e1y), XMVectorMultiply(ty, e1x));
+
+		XMVECTOR v = XMVectorMultiply(XMVectorMultiplyAdd(rays.directionX, qx, XMVectorMultiplyAdd(rays.directionY, qy, XMVectorMultiply(rays.directionZ, qz))), invDeterminant);
+		XMVECTOR distance = XMVectorMultiply(XMVectorMultiplyAdd(e2x, qx, XMVectorMultiplyAdd(e2y, qy, XMVectorMultiply(e2z, qz))), invDeterminant);
+
+		XMVECTOR zero = XMVectorZero();
+		valid = XMVectorAndInt(valid, XMVectorGreaterOrEqual(u, zero));
+		valid = XMVectorAndInt(valid, XMVectorGreaterOrEqual(v, zero));
+		valid = XMVectorAndInt(valid, XMVectorLessOrEqual(XMVectorAdd(u, v), XMVectorSplatOne()));
+		valid = XMVectorAndInt(valid, XMVectorGreaterOrEqual(distance, zero));
+		valid = XMVectorAndInt(valid, XMVectorLessOrEqual(distance, closest));
+
+		outDistance = distance;
+		outU = u;
+		outV = v;
+
+		return LaneMask(valid);
+	}
+}
+
+void MeshBVH::Build(const StaticMeshData& mesh)
+{
+	Clear();
+
+	const auto& vertices = mesh.GetVertices();
+	const auto& indices = mesh.GetIndices();
+	const auto& sections = mesh.GetMeshSections();
+
+	//  ε  ȿ  ȣ vertexOffset ؾ ü  迭 ġ 
+	std::vector<MeshBVHTriangle> sourceTriangles;
+	std::vector<BuildTriangle> buildTriangles;
+	sourceTriangles.reserve(indices.size() / 3);
+	buildTriangles.reserve(indices.size() / 3);
+
+	XMFLOAT3 boundsMin{ FLT_MAX, FLT_MAX, FLT_MAX };
+	XMFLOAT3 boundsMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	for (std::uint32_t sectionIndex = 0; sectionIndex < sections.size(); ++sectionIndex)
+	{
+		const auto& section = sections[sectionIndex];
+
+		for (UINT i = 0; i + 2 < section.indexCount; i += 3)
+		{
+			UINT index = section.indexOffset + i;
+
+			const XMFLOAT3& p0 = vertices[section.vertexOffset + indices[index]].position;
+			const XMFLOAT3& p1 = vertices[section.vertexOffset + indices[index + 1]].position;
+			const XMFLOAT3& p2 = vertices[section.vertexOffset + indices[index + 2]].position;
+
+			MeshBVHTriangle triangle;
+			triangle.v0 = p0;
+			triangle.edge1 = Subtract(p1, p0);
+			triangle.edge2 = Subtract(p2, p0);
+			triangle.triangleIndex = index / 3;
+			triangle.sectionIndex = sectionIndex;
+
+			BuildTriangle buildTriangle;
+			buildTriangle.min = { std::min({ p0.x, p1.x, p2.x }), std::min({ p0.y, p1.y, p2.y }), std::min({ p0.z, p1.z, p2.z }) };
+			buildTriangle.max = { std::max({ p0.x, p1.x, p2.x }), std::max({ p0.y, p1.y, p2.y }), std::max({ p0.z, p1.z, p2.z }) };
+			buildTriangle.centroid = {
+				(buildTriangle.min.x + buildTriangle.max.x) * 0.5f,
+				(buildTriangle.min.y + buildTriangle.max.y) * 0.5f,
+				(buildTriangle.min.z + buildTriangle.max.z) * 0.5f
+			};
+
+			Grow(boundsMin, boundsMax, buildTriangle.min, buildTriangle.max);
+
+			sourceTriangles.push_back(triangle);
+			buildTriangles.push_back(buildTriangle);
+		}
+	}
+
+	if (sourceTriangles.empty())
+	{
+		return;
+	}
+
+	DirectX::BoundingBox::CreateFromPoints(m_bounds, DirectX::XMLoadFloat3(&boundsMin), DirectX::XMLoadFloat3(&boundsMax));
+
+	// 1. binned SAH  Ʈ 
+	std::vector<std::uint32_t> order(sourceTriangles.size());
+	for (std::uint32_t i = 0; i < order.size(); ++i)
+	{
+		order[i] = i;
+	}
+
+	struct SplitItem
+	{
+		std::uint32_t nodeIndex;
+		std::uint32_t begin;
+		std::uint32_t end;
+		std::uint32_t depth;
+	};
+
+	std::vector<BuildNode> buildNodes;
+	buildNodes.reserve(sourceTriangles.size() * 2 / MAX_LEAF_TRIANGLES + 1);
+	buildNodes.emplace_back();
+
+	std::vector<SplitItem> splitStack;
+	splitStack.push_back({ 0, 0, static_cast<std::uint32_t>(order.size()), 1 });
+
+	while (!splitStack.empty())
+	{
+		SplitItem item = splitStack.back();
+		splitStack.pop_back();
+
+		XMFLOAT3 nodeMin{ FLT_MAX, FLT_MAX, FLT_MAX };
+		XMFLOAT3 nodeMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		XMFLOAT3 centroidMin{ FLT_MAX, FLT_MAX, FLT_MAX };
+		XMFLOAT3 centroidMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+		for (std::uint32_t i = item.begin; i < item.end; ++i)
+		{
+			const auto& triangle = buildTriangles[order[i]];
+
+			Grow(nodeMin, nodeMax, triangle.min, triangle.max);
+			Grow(centroidMin, centroidMax, triangle.centroid, triangle.centroid);
+		}
+
+		buildNodes[item.nodeIndex].min = nodeMin;
+		buildNodes[item.nodeIndex].max = nodeMax;
+
+		std::uint32_t count = item.end - item.begin;
+
+		if (count <= MAX_LEAF_TRIANGLES || item.depth >= MAX_DEPTH)
+		{
+			buildNodes[item.nodeIndex].first = item.begin;
+			buildNodes[item.nodeIndex].count = count;
+
+			continue;
+		}
+
+		std::uint32_t middle = SplitWithSAH(order, buildTriangles, item.begin, item.end, centroidMin, centroidMax);
+
+		// ߽  ļ    ݾ
+		if (middle == item.begin || middle == item.end)
+		{
+			middle = item.begin + count / 2;
+		}
+
+		std::uint32_t left = static_cast<std::uint32_t>(buildNodes.size());
+		buildNodes.emplace_back();
+		buildNodes.emplace_back();
+
+		buildNodes[item.nodeIndex].left = left;
+		buildNodes[item.nodeIndex].right = left + 1;
+
+		splitStack.push_back({ left, item.begin, middle, item.depth + 1 });
+		splitStack.push_back({ left + 1, middle, item.end, item.depth + 1 });
+	}
+
+	// 2. ǥ ū   ļ ڽ 4¥  
+	m_nodes.reserve(buildNodes.size() / 2 + 1);
+	m_triangles.reserve(sourceTriangles.size());
+
+	struct CollapseItem
+	{
+		std::uint32_t buildIndex;
+		std::uint32_t nodeIndex;
+	};
+
+	std::vector<CollapseItem> collapseStack;
+	collapseStack.push_back({ 0, 0 });
+	m_nodes.emplace_back();
+
+	while (!collapseStack.empty())
+	{
+		CollapseItem item = collapseStack.back();
+		collapseStack.pop_back();
+
+		std::uint32_t lanes[WIDTH];
+		std::uint32_t laneCount = 0;
+
+		const auto& buildNode = buildNodes[item.buildIndex];
+
+		if (buildNode.IsLeaf())
+		{
+			// ﰢ MAX_LEAF_TRIANGLES  ޽
+			lanes[laneCount++] = item.buildIndex;
+		}
+		else
+		{
+			lanes[laneCount++] = buildNode.left;
+			lanes[laneCount++] = buildNode.right;
+
+			while (laneCount < WIDTH)
+			{
+				int bestLane = -1;
+				float bestArea = -1.0f;
+
+				for (std::uint32_t i = 0; i < laneCount; ++i)
+				{
+					const auto& candidate = buildNodes[lanes[i]];
+					if (candidate.IsLeaf())
+					{
+						continue;
+					}
+
+					float area = HalfSurfaceArea(candidate.min, candidate.max);
+					if (area > bestArea)
+					{
+						bestArea = area;
+						bestLane = static_cast<int>(i);
+					}
+				}
+
+				if (bestLane == -1)
+				{
+					break;
+				}
+
+				const auto& opened = buildNodes[lanes[bestLane]];
+				lanes[bestLane] = opened.left;
+				lanes[laneCount++] = opened.right;
+			}
+		}
+
+		MeshBVHNode node;
+
+		for (std::uint32_t lane = 0; lane < WIDTH; ++lane)
+		{
+			if (lane >= laneCount)
+			{
+				BVH4::ClearLane(node, lane);
+				continue;
+			}
+
+			const auto& laneNode = buildNodes[lanes[lane]];
+
+			node.minX[lane] = laneNode.min.x;
+			node.minY[lane] = laneNode.min.y;
+			node.minZ[lane] = laneNode.min.z;
+			node.maxX[lane] = laneNode.max.x;
+			node.maxY[lane] = laneNode.max.y;
+			node.maxZ[lane] = laneNode.max.z;
+
+			if (laneNode.IsLeaf())
+			{
+				node.child[lane] = static_cast<std::uint32_t>(m_triangles.size());
+				node.count[lane] = laneNode.count;
+
+				for (std::uint32_t i = 0; i < laneNode.count; ++i)
+				{
+					m_triangles.push_back(sourceTriangles[order[laneNode.first + i]]);
+				}
+			}
+			else
+			{
+				node.child[lane] = static_cast<std::uint32_t>(m_nodes.size());
+				node.count[lane] = 0;
+
+				m_nodes.emplace_back();
+				collapseStack.push_back({ lanes[lane], node.child[lane] });
+			}
+		}
+
+		m_nodes[item.nodeIndex] = node;
+	}
+}
+
+void MeshBVH::Clear()
+{
+	m_nodes.clear();
+	m_triangles.clear();
+	m_bounds = DirectX::BoundingBox();
+}
+
+bool MeshBVH::Raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, MeshRayHit& outHit) const
+{
+	return TraverseRay<false>(origin, direction, maxDistance, &outHit);
+}
+
+bool MeshBVH::RaycastAny(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance) const
+{
+	return TraverseRay<true>(origin, direction, maxDistance, nullptr);
+}
+
+std::uint32_t MeshBVH::RaycastPacket(const MeshRayPacket& packet, MeshRayHit outHits[PACKET_SIZE]) const
+{
+	return TraversePacket<false>(packet, outHits);
+}
+
+std::uint32_t MeshBVH::RaycastPacketAny(const MeshRayPacket& packet) const
+{
+	return TraversePacket<true>(packet, nullptr);
+}
+
+bool MeshBVH::IsEmpty() const
+{
+	return m_nodes.empty();
+}
+
+const DirectX::BoundingBox& MeshBVH::GetBounds() const
+{
+	return m_bounds;
+}
+
+std::uint32_t MeshBVH::GetNodeCount() const
+{
+	return static_cast<std::uint32_t>(m_nodes.size());
+}
+
+std::uint32_t MeshBVH::GetTriangleCount() const
+{
+	return static_cast<std::uint32_t>(m_triangles.size());
+}
+
+template<bool IsAnyHit>
+bool MeshBVH::TraverseRay(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, MeshRayHit* outHit) const
+{
+	using namespace DirectX;
+
+	if (m_nodes.empty())
+	{
+		return false;
+	}
+
+	XMFLOAT3 invDirection{ 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+	XMVECTOR originX = XMVectorReplicate(origin.x);
+	XMVECTOR originY = XMVectorReplicate(origin.y);
+	XMVECTOR originZ = XMVectorReplicate(origin.z);
+	XMVECTOR invX = XMVectorReplicate(invDirection.x);
+	XMVECTOR invY = XMVectorReplicate(invDirection.y);
+	XMVECTOR invZ = XMVectorReplicate(invDirection.z);
+
+	//    max    
+	XMVECTOR negativeX = invDirection.x < 0.0f ? XMVectorTrueInt() : XMVectorFalseInt();
+	XMVECTOR negativeY = invDirection.y < 0.0f ? XMVectorTrueInt() : XMVectorFalseInt();
+	XMVECTOR negativeZ = invDirection.z < 0.0f ? XMVectorTrueInt() : XMVectorFalseInt();
+	XMVECTOR zero = XMVectorZero();
+
+	float closest = maxDistance;
+	bool hit = false;
+
+	std::uint32_t stack[STACK_SIZE];
+	std::uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize != 0)
+	{
+		const auto& node = m_nodes[stack[--stackSize]];
+		Lanes lanes = LoadLanes(node);
+
+		XMVECTOR tNearX = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.minX, lanes.maxX, negativeX), originX), invX);
+		XMVECTOR tNearY = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.minY, lanes.maxY, negativeY), originY), invY);
+		XMVECTOR tNearZ = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.minZ, lanes.maxZ, negativeZ), originZ), invZ);
+		XMVECTOR tFarX = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.maxX, lanes.minX, negativeX), originX), invX);
+		XMVECTOR tFarY = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.maxY, lanes.minY, negativeY), originY), invY);
+		XMVECTOR tFarZ = XMVectorMultiply(XMVectorSubtract(XMVectorSelect(lanes.maxZ, lanes.minZ, negativeZ), originZ), invZ);
+
+		XMVECTOR tNear = XMVectorMax(XMVectorMax(tNearX, tNearY), XMVectorMax(tNearZ, zero));
+		XMVECTOR tFar = XMVectorMin(XMVectorMin(tFarX, tFarY), XMVectorMin(tFarZ, XMVectorReplicate(closest)));
+
+		std::uint32_t hitMask = LaneMask(XMVectorLessOrEqual(tNear, tFar));
+		if (hitMask == 0)
+		{
+			continue;
+		}
+
+		XMFLOAT4A nearDistances;
+		XMStoreFloat4A(&nearDistances, tNear);
+		const float* laneDistances = &nearDistances.x;
+
+		//    ͺ ־  尡  
+		std::uint32_t pending[WIDTH];
+		float pendingDistances[WIDTH];
+		std::uint32_t pendingCount = 0;
+
+		for (std::uint32_t lane = 0; lane < WIDTH; ++lane)
+		{
+			if (!(hitMask & (1u << lane)) || BVH4::IsEmptyLane(node, lane))
+			{
+				continue;
+			}
+
+			if (node.count[lane] == 0)
+			{
+				std::uint32_t insertAt = pendingCount++;
+				while (insertAt > 0 && pendingDistances[insertAt - 1] < laneDistances[lane])
+				{
+					pending[insertAt] = pending[insertAt - 1];
+					pendingDistances[insertAt] = pendingDistances[insertAt - 1];
+					--insertAt;
+				}
+
+				pending[insertAt] = node.child[lane];
+				pendingDistances[insertAt] = laneDistances[lane];
+
+				continue;
+			}
+
+			for (std::uint32_t i = 0; i < node.count[lane]; ++i)
+			{
+				const auto& triangle = m_triangles[node.child[lane] + i];
+
+				float distance;
+				float u;
+				float v;
+
+				if (!IntersectTriangle(triangle, origin, direction, closest, distance, u, v))
+				{
+					continue;
+				}
+
+				if constexpr (IsAnyHit)
+				{
+					return true;
+				}
+				else
+				{
+					closest = distance;
+					hit = true;
+
+					outHit->distance = distance;
+					outHit->u = u;
+					outHit->v = v;
+					outHit->triangleIndex = triangle.triangleIndex;
+					outHit->sectionIndex = triangle.sectionIndex;
+				}
+			}
+		}
+
+		for (std::uint32_t i = 0; i < pendingCount; ++i)
+		{
+			if (pendingDistances[i] <= closest)
+			{
+				stack[stackSize++] = pending[i];
+			}
+		}
+	}
+
+	return hit;
+}
+
+template<bool IsAnyHit>
+std::uint32_t MeshBVH::TraversePacket(const MeshRayPacket& packet, MeshRayHit* outHits) const
+{
+	using namespace DirectX;
+
+	std::uint32_t rayCount = std::min(packet.count, PACKET_SIZE);
+
+	if (m_nodes.empty() || rayCount == 0)
+	{
+		return 0;
+	}
+
+	//  ʴ  /0Ÿ  ä ũ 
+	XMFLOAT4A origins[3] = {};
+	XMFLOAT4A directions[3] = {};
+	XMFLOAT4A inverses[3] = {};
+	XMFLOAT4A distances = { -1.0f, -1.0f, -1.0f, -1.0f };
+
+	for (std::uint32_t i = 0; i < rayCount; ++i)
+	{
+		const auto& o = packet.origins[i];
+		const auto& d = packet.directions[i];
+
+		(&origins[0].x)[i] = o.x;
+		(&origins[1].x)[i] = o.y;
+		(&origins[2].x)[i] = o.z;
+		(&directions[0].x)[i] = d.x;
+		(&directions[1].x)[i] = d.y;
+		(&directions[2].x)[i] = d.z;
+		(&inverses[0].x)[i] = 1.0f / d.x;
+		(&inverses[1].x)[i] = 1.0f / d.y;
+		(&inverses[2].x)[i] = 1.0f / d.z;
+		(&distances.x)[i] = packet.maxDistances[i];
+	}
+
+	PacketLanes rays;
+	rays.originX = XMLoadFloat4A(&origins[0]);
+	rays.originY = XMLoadFloat4A(&origins[1]);
+	rays.originZ = XMLoadFloat4A(&origins[2]);
+	rays.directionX = XMLoadFloat4A(&directions[0]);
+	rays.directionY = XMLoadFloat4A(&directions[1]);
+	rays.directionZ = XMLoadFloat4A(&directions[2]);
+	rays.invX = XMLoadFloat4A(&inverses[0]);
+	rays.invY = XMLoadFloat4A(&inverses[1]);
+	rays.invZ = XMLoadFloat4A(&inverses[2]);
+
+	//  ݱ    Ÿ. ̺   ﰢ ǳʶ
+	XMVECTOR closest = XMLoadFloat4A(&distances);
+	XMVECTOR zero = XMVectorZero();
+
+	const std::uint32_t activeRays = (1u << rayCount) - 1;
+	std::uint32_t hitRays = 0;
+
+	std::uint32_t stack[STACK_SIZE];
+	std::uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize != 0)
+	{
+		const auto& node = m_nodes[stack[--stackSize]];
+
+		// ڽ Ը  4   ˻
+		for (int lane = static_cast<int>(WIDTH) - 1; lane >= 0; --lane)
+		{
+			if (BVH4::IsEmptyLane(node, lane))
+			{
+				continue;
+			}
+
+			XMVECTOR t1x = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(node.minX[lane]), rays.originX), rays.invX);
+			XMVECTOR t2x = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(node.maxX[lane]), rays.originX), rays.invX);
+			XMVECTOR t1y = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(node.minY[lane]), rays.originY), rays.invY);
+			XMVECTOR t2y = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(node.maxY[lane]), rays.originY), rays.invY);
+			XMVECTOR t1z = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(node.minZ[lane]), rays.originZ), rays.invZ);
+			XMVECTOR t2z = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(node.maxZ[lane]), rays.originZ), rays.invZ);
+
+			XMVECTOR tNear = XMVectorMax(XMVectorMax(XMVectorMin(t1x, t2x), XMVectorMin(t1y, t2y)), XMVectorMax(XMVectorMin(t1z, t2z), zero));
+			XMVECTOR tFar = XMVectorMin(XMVectorMin(XMVectorMax(t1x, t2x), XMVectorMax(t1y, t2y)), XMVectorMin(XMVectorMax(t1z, t2z), closest));
+
+			std::uint32_t laneRays = LaneMask(XMVectorLessOrEqual(tNear, tFar)) & activeRays;
+			if (laneRays == 0)
+			{
+				continue;
+			}
+
+			if (node.count[lane] == 0)
+			{
+				stack[stackSize++] = node.child[lane];
+				continue;
+			}
+
+			for (std::uint32_t i = 0; i < node.count[lane]; ++i)
+			{
+				const auto& triangle = m_triangles[node.child[lane] + i];
+
+				XMVECTOR distance;
+				XMVECTOR u;
+				XMVECTOR v;
+
+				std::uint32_t triangleRays = IntersectTrianglePacket(triangle, rays, closest, distance, u, v) & activeRays;
+				if (triangleRays == 0)
+				{
+					continue;
+				}
+
+				if constexpr (IsAnyHit)
+				{
+					hitRays |= triangleRays;
+					if (hitRays == activeRays)
+					{
+						return hitRays;
+					}
+
+					// ̹   Ÿ    ̻  嵵  ϰ 
+					XMVECTOR hitSelect = XMVectorSelectControl(hitRays & 1, (hitRays >> 1) & 1, (hitRays >> 2) & 1, (hitRays >> 3) & 1);
+					closest = XMVectorSelect(closest, XMVectorReplicate(-1.0f), hitSelect);
+				}
+				else
+				{
+					hitRays |= triangleRays;
+
+					XMVECTOR hitSelect = XMVectorSelectControl(triangleRays & 1, (triangleRays >> 1) & 1, (triangleRays >> 2) & 1, (triangleRays >> 3) & 1);
+					closest = XMVectorSelect(closest, distance, hitSelect);
+
+					XMFLOAT4A distanceLanes;
+					XMFLOAT4A uLanes;
+					XMFLOAT4A vLanes;
+					XMStoreFloat4A(&distanceLanes, distance);
+					XMStoreFloat4A(&uLanes, u);
+					XMStoreFloat4A(&vLanes, v);
+
+					for (std::uint32_t ray = 0; ray < rayCount; ++ray)
+					{
+						if (!(triangleRays & (1u << ray)))
+						{
+							continue;
+						}
+
+						outHits[ray].distance = (&distanceLanes.x)[ray];
+						outHits[ray].u = (&uLanes.x)[ray];
+						outHits[ray].v = (&vLanes.x)[ray];
+						outHits[ray].triangleIndex = triangle.triangleIndex;
+						outHits[ray].sectionIndex = triangle.sectionIndex;
+					}
+				}
+			}
+		}
+	}
+
+	return hitRays;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <DirectXCollision.h>
+
+#include "BVH4.h"
+
+class StaticMeshData;
+
+//   child count ﰢ 迭 
+using MeshBVHNode = BVH4Node;
+
+//  꿡 ٷ  v0   ̸ ؼ    ﰢ
+struct MeshBVHTriangle
+{
+	DirectX::XMFLOAT3 v0;
+	DirectX::XMFLOAT3 edge1;
+	DirectX::XMFLOAT3 edge2;
+	//  ε   ﰢ ȣ (ε / 3)
+	std::uint32_t triangleIndex;
+	std::uint32_t sectionIndex;
+};
+
+struct MeshRayHit
+{
+	float distance = 0.0f;
+	//   = v0 + u * edge1 + v * edge2
+	float u = 0.0f;
+	float v = 0.0f;
+	std::uint32_t triangleIndex = 0;
+	std::uint32_t sectionIndex = 0;
+};
+
+//   ȸ  4.   Ҽ(ֺ ȼ, ׸ )  带   ̵ ŭ
+struct MeshRayPacket
+{
+	DirectX::XMFLOAT3 origins[4];
+	DirectX::XMFLOAT3 directions[4];
+	float maxDistances[4];
+	// տ    (1~4)
+	std::uint32_t count = 4;
+};
+
+// StaticMeshData ﰢ  б  BVH4. ޽   ̶
+// νϽ   ķ Űܼ ϸ  ϳ  νϽ   
+//   ¸ ٲ Ƿ  忡 ÿ ȣص .  
+class MeshBVH
+{
+public:
+	static constexpr std::uint32_t WIDTH = BVH4::WIDTH;
+	static constexpr std::uint32_t PACKET_SIZE = 4;
+	static constexpr std::uint32_t EMPTY_LANE = BVH4::EMPTY_LANE;
+	static constexpr std::uint32_t MAX_LEAF_TRIANGLES = 4;
+	//  ̿  ﰢ Ƶ  .   Լ   迭   
+	static constexpr std::uint32_t MAX_DEPTH = 64;
+
+private:
+	std::vector<MeshBVHNode> m_nodes;
+	std::vector<MeshBVHTriangle> m_triangles;
+	DirectX::BoundingBox m_bounds;
+
+public:
+	void Build(const StaticMeshData& mesh);
+	void Clear();
+
+	//   
+	bool Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, MeshRayHit& outHit) const;
+	// ƹ  ã ٷ  (ü, ׸ )
+	bool RaycastAny(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance) const;
+
+	//  4 SIMD   ȸ. ȯ   Ʈ ṵ̃ outHits   ä
+	std::uint32_t RaycastPacket(const MeshRayPacket& packet, MeshRayHit outHits[PACKET_SIZE]) const;
+	std::uint32_t RaycastPacketAny(const MeshRayPacket& packet) const;
+
+	bool IsEmpty() const;
+	const DirectX::BoundingBox& GetBounds() const;
+	std::uint32_t GetNodeCount() const;
+	std::uint32_t GetTriangleCount() const;
+
+private:
+	template<bool IsAnyHit>
+	bool TraverseRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, MeshRayHit* outHit) const;
+	template<bool IsAnyHit>
+	std::uint32_t TraversePacket(const MeshRayPacket& packet, MeshRayHit* outHits) const;
+};
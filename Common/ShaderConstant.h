@@ -9,14 +9,26 @@ enum class ConstantBufferSlot : UINT
 	Material = 2,
 	BonePoseMatrix = 3,
 	BoneOffsetMatrix = 4,
-	WorldTransform = 5
+	WorldTransform = 5,
+	BakedAnimation = 9
 };
 
 struct WorldTransformBuffer
 {
 	DirectX::SimpleMath::Matrix world;
 	unsigned int refBoneIndex;
-	float __pad1[3];
+	// Ű ȷƮ StructuredBuffer  νϽ   
+	unsigned int paletteOffset;
+	float __pad1[2];
+};
+
+// BakedAnimationData::FindFrame 
+struct BakedAnimationBuffer
+{
+	unsigned int frameRow0;
+	unsigned int frameRow1;
+	float frameLerp;
+	float __pad1;
 };
 
 struct TransformBuffer
@@ -54,6 +54,9 @@ void SkeletalMeshData::Create(const aiScene* scene, const std::shared_ptr<Skelet
 					&mesh->mBitangents[j].x);
 			}
 
+			DirectX::BoundingBox::CreateFromPoints(m_meshSections[i].bounds, mesh->mNumVertices,
+				&m_vertices[m_meshSections[i].vertexOffset].position, sizeof(CommonVertex3D));
+
 			for (unsigned int j = 0; j < mesh->mNumFaces; ++j)
 			{
 				m_indices.push_back(mesh->mFaces[j].mIndices[0]);
@@ -113,7 +116,13 @@ void SkeletalMeshData::Create(const aiScene* scene, const std::shared_ptr<Skelet
 
 				const unsigned int boneIndex = skeletonData->GetBoneIndexByBoneName(boneName);
 
-				skeletonData->SetBoneOffset(DirectX::SimpleMath::Matrix(&bone->mOffsetMatrix.a1), boneIndex);
+				const DirectX::SimpleMath::Matrix offset(&bone->mOffsetMatrix.a1);
+				skeletonData->SetBoneOffset(offset, boneIndex);
+
+				// aiMatrix ״ о ̴ ġ ̹Ƿ CPU   ٽ ġ
+				const DirectX::SimpleMath::Matrix boneSpace = offset.Transpose();
+				BoneBounds boneBounds{ boneIndex };
+				bool hasVertex = false;
 
 				for (unsigned int k = 0; k < bone->mNumWeights; ++k)
 				{
@@ -121,6 +130,30 @@ void SkeletalMeshData::Create(const aiScene* scene, const std::shared_ptr<Skelet
 					float weight = bone->mWeights[k].mWeight;
 
 					m_boneWeightVertices[vertexId].AddBoneData(boneIndex, weight);
+
+					if (weight <= 0.0f)
+					{
+						continue;
+					}
+
+					DirectX::BoundingBox point(
+						DirectX::SimpleMath::Vector3::Transform(m_boneWeightVertices[vertexId].position, boneSpace),
+						DirectX::SimpleMath::Vector3::Zero);
+
+					if (hasVertex)
+					{
+						DirectX::BoundingBox::CreateMerged(boneBounds.bounds, boneBounds.bounds, point);
+					}
+					else
+					{
+						boneBounds.bounds = point;
+						hasVertex = true;
+					}
+				}
+
+				if (hasVertex)
+				{
+					m_meshSections[i].boneBounds.push_back(boneBounds);
 				}
 			}
 		}
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <DirectXCollision.h>
 
 #include "../Common/Vertex.h"
 
@@ -11,6 +12,13 @@
 struct aiScene;
 class SkeletonData;
 
+struct BoneBounds
+{
+    unsigned int boneIndex;
+    //    ( )    ִ  AABB
+    DirectX::BoundingBox bounds;
+};
+
 struct SkeletalMeshSection
 {
     std::wstring name;
@@ -19,6 +27,11 @@ struct SkeletalMeshSection
     INT vertexOffset;
     UINT indexOffset;
     UINT indexCount;
+    // :     AABB
+    DirectX::BoundingBox bounds;
+    // Ű: Ű׵   ȯ   ̶  AABB   Ű ġ ׻ .
+    //   ġ ִ   ̰ ׷   ̹Ƿ    
+    std::vector<BoneBounds> boneBounds;
 };
 
 class SkeletalMeshData :
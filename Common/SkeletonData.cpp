@@ -52,6 +52,8 @@ void SkeletonData::Create(const aiScene* scene)
 
 		nodeQueue.pop();
 	}
+
+	m_leafLODMask = BoneMask::CreateWithoutLeaves(m_bones);
 }
 
 const std::vector<BoneInfo>& SkeletonData::GetBones() const
@@ -87,6 +89,11 @@ const BoneMatrixArray& SkeletonData::GetBoneOffsets() const
 	return m_boneOffsets;
 }
 
+const BoneMask& SkeletonData::GetLeafLODMask() const
+{
+	return m_leafLODMask;
+}
+
 void SkeletonData::SetBoneOffset(const DirectX::SimpleMath::Matrix& offset, unsigned int boneIndex)
 {
 	m_boneOffsets[boneIndex] = offset;
@@ -100,4 +107,41 @@ void SkeletonData::SetupSkeletonInstance(std::vector<Bone>& out) const
 	{
 		out.emplace_back(bone.name, bone.parentIndex, bone.index, bone.relative);
 	}
+}
+
+BoneMask BoneMask::CreateFromRoot(const std::vector<Bone>& skeleton, const std::wstring& rootBoneName)
+{
+	BoneMask mask;
+	mask.weights.resize(skeleton.size(), 0.0f);
+
+	// θ ڽĺ տ Ƿ θ  ״  
+	for (const auto& bone : skeleton)
+	{
+		if (bone.name == rootBoneName)
+		{
+			mask.weights[bone.index] = 1.0f;
+		}
+		else if (bone.parentIndex != -1)
+		{
+			mask.weights[bone.index] = mask.weights[bone.parentIndex];
+		}
+	}
+
+	return mask;
+}
+
+BoneMask BoneMask::CreateWithoutLeaves(const std::vector<BoneInfo>& bones)
+{
+	BoneMask mask;
+	mask.weights.resize(bones.size(), 0.0f);
+
+	for (const auto& bone : bones)
+	{
+		if (bone.parentIndex != -1)
+		{
+			mask.weights[bone.parentIndex] = 1.0f;
+		}
+	}
+
+	return mask;
 }
\ No newline at end of file
@@ -52,6 +52,17 @@ struct Bone
 	}
 };
 
+//  ̾ ġ(0 ~ 1)
+struct BoneMask
+{
+	std::vector<float> weights;
+
+	// rootBoneName  ڼո 1,  0
+	static BoneMask CreateFromRoot(const std::vector<Bone>& skeleton, const std::wstring& rootBoneName);
+	// ڽ   0. ָ ִ νϽ հ    ø ǳʶ  
+	static BoneMask CreateWithoutLeaves(const std::vector<BoneInfo>& bones);
+};
+
 struct aiScene;
 
 class SkeletonData :
@@ -66,6 +77,8 @@ private:
 	std::unordered_map<BoneName, BoneIndex> m_boneMappingTable;
 	std::unordered_map<MeshName, BoneIndex> m_meshMappingTable;
 	BoneMatrixArray m_boneOffsets;
+	// ̷渶    νϽ  
+	BoneMask m_leafLODMask;
 
 public:
 	void Create(const aiScene* scene);
@@ -76,6 +89,8 @@ public:
 	unsigned int GetBoneIndexByMeshName(const std::wstring& meshName) const;
 	BoneInfo* GetBoneInfoByIndex(size_t index);
 	const BoneMatrixArray& GetBoneOffsets() const;
+	//   0 ũ. ִϸ̼ LOD   ø ǳʶ  
+	const BoneMask& GetLeafLODMask() const;
 
 	void SetBoneOffset(const DirectX::SimpleMath::Matrix& offset, unsigned int boneIndex);
 
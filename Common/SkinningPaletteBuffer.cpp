@@ -0,0 +1,88 @@
+#include "SkinningPaletteBuffer.h"
+
+#include <algorithm>
+
+bool SkinningPaletteBuffer::Create(const Microsoft::WRL::ComPtr<ID3D11Device>& device, UINT capacity)
+{
+	m_device = device;
+	capacity = std::max<UINT>(capacity, 1);
+
+	D3D11_BUFFER_DESC bufferDesc{};
+	bufferDesc.ByteWidth = capacity * sizeof(DirectX::SimpleMath::Matrix);
+	bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+	bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+	bufferDesc.StructureByteStride = sizeof(DirectX::SimpleMath::Matrix);
+
+	//    ڿ ٲ㼭 Ű ص  ۿ 뷮 ״ 
+	Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+	if (FAILED(device->CreateBuffer(&bufferDesc, nullptr, &buffer)))
+	{
+		return false;
+	}
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+	srvDesc.Buffer.FirstElement = 0;
+	srvDesc.Buffer.NumElements = capacity;
+
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> shaderResourceView;
+	if (FAILED(device->CreateShaderResourceView(buffer.Get(), &srvDesc, &shaderResourceView)))
+	{
+		return false;
+	}
+
+	m_buffer = buffer;
+	m_shaderResourceView = shaderResourceView;
+	m_capacity = capacity;
+
+	return true;
+}
+
+DirectX::SimpleMath::Matrix* SkinningPaletteBuffer::Map(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext, UINT matrixCount)
+{
+	if (matrixCount > m_capacity)
+	{
+		// ó Create  뷮 0
+		UINT capacity = std::max<UINT>(m_capacity, 1);
+		while (capacity < matrixCount)
+		{
+			capacity *= 2;
+		}
+
+		if (!Create(m_device, capacity))
+		{
+			return nullptr;
+		}
+	}
+
+	if (m_buffer == nullptr)
+	{
+		return nullptr;
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mapped{};
+	if (FAILED(deviceContext->Map(m_buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		return nullptr;
+	}
+
+	return static_cast<DirectX::SimpleMath::Matrix*>(mapped.pData);
+}
+
+void SkinningPaletteBuffer::Unmap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext)
+{
+	deviceContext->Unmap(m_buffer.Get(), 0);
+}
+
+const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& SkinningPaletteBuffer::GetShaderResourceView() const
+{
+	return m_shaderResourceView;
+}
+
+UINT SkinningPaletteBuffer::GetCapacity() const
+{
+	return m_capacity;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <directxtk/SimpleMath.h>
+
+#include "D3DResource.h"
+
+// Ӹ  νϽ  Ű ( ̸ ϰ ġ )   ø  StructuredBuffer
+// Map  WRITE_DISCARD ̹   ޸𸮸  , νϽ    ڱ  ã
+class SkinningPaletteBuffer :
+	public D3DResource
+{
+private:
+	Microsoft::WRL::ComPtr<ID3D11Device> m_device;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> m_buffer;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_shaderResourceView;
+	//  
+	UINT m_capacity = 0;
+
+public:
+	// ϸ falsḛ  ۿ 뷮 ״ 
+	bool Create(const Microsoft::WRL::ComPtr<ID3D11Device>& device, UINT capacity);
+
+	// matrixCount 뷮 ũ  辿 Ű ٽ . Ű⳪ Map ϸ nullptr
+	DirectX::SimpleMath::Matrix* Map(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext, UINT matrixCount);
+	void Unmap(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext);
+
+public:
+	const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& GetShaderResourceView() const;
+	UINT GetCapacity() const;
+};
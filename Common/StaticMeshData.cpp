@@ -66,6 +66,18 @@ void StaticMeshData::Create(const aiScene* scene)
 				&mesh->mBitangents[j].x);
 		}
 
+		DirectX::BoundingBox::CreateFromPoints(m_meshSections[i].bounds, mesh->mNumVertices,
+			&m_vertices[m_meshSections[i].vertexOffset].position, sizeof(CommonVertex3D));
+
+		if (i == 0)
+		{
+			m_bounds = m_meshSections[i].bounds;
+		}
+		else
+		{
+			DirectX::BoundingBox::CreateMerged(m_bounds, m_bounds, m_meshSections[i].bounds);
+		}
+
 		for (unsigned int j = 0; j < mesh->mNumFaces; ++j)
 		{
 			m_indices.push_back(mesh->mFaces[j].mIndices[0]);
@@ -73,6 +85,8 @@ void StaticMeshData::Create(const aiScene* scene)
 			m_indices.push_back(mesh->mFaces[j].mIndices[2]);
 		}
 	}
+
+	m_meshBVH.Build(*this);
 }
 
 const std::vector<CommonVertex3D>& StaticMeshData::GetVertices() const
@@ -88,4 +102,14 @@ const std::vector<DWORD>& StaticMeshData::GetIndices() const
 const std::vector<StaticMeshSection>& StaticMeshData::GetMeshSections() const
 {
 	return m_meshSections;
+}
+
+const DirectX::BoundingBox& StaticMeshData::GetBounds() const
+{
+	return m_bounds;
+}
+
+const MeshBVH& StaticMeshData::GetMeshBVH() const
+{
+	return m_meshBVH;
 }
\ No newline at end of file
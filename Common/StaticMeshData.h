@@ -2,10 +2,12 @@
 
 #include <vector>
 #include <string>
+#include <DirectXCollision.h>
 
 #include "../Common/Vertex.h"
 
 #include "AssetData.h"
+#include "MeshBVH.h"
 
 struct aiScene;
 
@@ -16,6 +18,8 @@ struct StaticMeshSection
     INT vertexOffset;
     UINT indexOffset;
     UINT indexCount;
+    // ޽   AABB
+    DirectX::BoundingBox bounds;
 };
 
 class StaticMeshData :
@@ -25,6 +29,9 @@ private:
     std::vector<CommonVertex3D> m_vertices;
     std::vector<DWORD> m_indices;
     std::vector<StaticMeshSection> m_meshSections;
+    DirectX::BoundingBox m_bounds;
+    // ε         νϽ 
+    MeshBVH m_meshBVH;
 
 public:
     void Create(const std::wstring& filePath);
@@ -34,4 +41,6 @@ public:
     const std::vector<CommonVertex3D>& GetVertices() const;
     const std::vector<DWORD>& GetIndices() const;
     const std::vector<StaticMeshSection>& GetMeshSections() const;
+    const DirectX::BoundingBox& GetBounds() const;
+    const MeshBVH& GetMeshBVH() const;
 };
\ No newline at end of file
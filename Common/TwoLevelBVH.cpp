@@ -0,0 +1,173 @@
+#include "TwoLevelBVH.h"
+
+#include "StaticMeshData.h"
+
+using DirectX::XMFLOAT3;
+
+std::uint32_t TwoLevelBVH::AddInstance(std::shared_ptr<const StaticMeshData> mesh, const DirectX::XMFLOAT4X4& world)
+{
+	std::uint32_t instanceID = m_tlas.Insert(CalculateWorldAABB(mesh->GetMeshBVH(), world));
+	std::uint32_t handleIndex = instanceID & BVH::HANDLE_INDEX_MASK;
+
+	if (handleIndex >= m_instances.size())
+	{
+		m_instances.resize(handleIndex + 1);
+	}
+
+	Instance& instance = m_instances[handleIndex];
+	instance.mesh = std::move(mesh);
+	DirectX::XMStoreFloat4x4(&instance.inverseWorld, DirectX::XMMatrixInverse(nullptr, DirectX::XMLoadFloat4x4(&world)));
+
+	++m_instanceCount;
+
+	return instanceID;
+}
+
+bool TwoLevelBVH::RemoveInstance(std::uint32_t instanceID)
+{
+	if (!m_tlas.Remove(instanceID))
+	{
+		return false;
+	}
+
+	m_instances[instanceID & BVH::HANDLE_INDEX_MASK].mesh.reset();
+	--m_instanceCount;
+
+	return true;
+}
+
+void TwoLevelBVH::SetTransform(std::uint32_t instanceID, const DirectX::XMFLOAT4X4& world)
+{
+	if (!m_tlas.IsValid(instanceID))
+	{
+		return;
+	}
+
+	Instance& instance = m_instances[instanceID & BVH::HANDLE_INDEX_MASK];
+	DirectX::XMStoreFloat4x4(&instance.inverseWorld, DirectX::XMMatrixInverse(nullptr, DirectX::XMLoadFloat4x4(&world)));
+
+	m_tlas.ChangeAABB(instanceID, CalculateWorldAABB(instance.mesh->GetMeshBVH(), world));
+	m_isDirty = true;
+}
+
+void TwoLevelBVH::Rebuild()
+{
+	m_tlas.FullyRebuild();
+	m_isDirty = false;
+}
+
+void TwoLevelBVH::Update()
+{
+	if (!m_isDirty)
+	{
+		return;
+	}
+
+	m_tlas.Refit();
+	m_isDirty = false;
+}
+
+bool TwoLevelBVH::Raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, SceneRayHit& outHit) const
+{
+	MeshRayHit closestHit;
+
+	// TLAS AABB  νϽ Ѱְ,  Ÿ  ٿ   νϽ ǳʶ
+	auto hitTest = [&](std::uint32_t instanceID, float closest)
+		{
+			const Instance* instance = FindInstance(instanceID);
+			if (instance == nullptr)
+			{
+				return -1.0f;
+			}
+
+			XMFLOAT3 localOrigin;
+			XMFLOAT3 localDirection;
+			TransformRay(*instance, origin, direction, localOrigin, localDirection);
+
+			MeshRayHit hit;
+			if (!instance->mesh->GetMeshBVH().Raycast(localOrigin, localDirection, closest, hit))
+			{
+				return -1.0f;
+			}
+
+			closestHit = hit;
+
+			return hit.distance;
+		};
+
+	std::uint32_t instanceID;
+	float distance;
+
+	if (!m_tlas.Raycast(origin, direction, maxDistance, hitTest, instanceID, distance))
+	{
+		return false;
+	}
+
+	outHit.instanceID = instanceID;
+	outHit.meshHit = closestHit;
+
+	return true;
+}
+
+bool TwoLevelBVH::RaycastAny(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance) const
+{
+	// ϳ  Ÿ 0 ༭  尡  ɷ 
+	auto hitTest = [&](std::uint32_t instanceID, float closest)
+		{
+			const Instance* instance = FindInstance(instanceID);
+			if (instance == nullptr)
+			{
+				return -1.0f;
+			}
+
+			XMFLOAT3 localOrigin;
+			XMFLOAT3 localDirection;
+			TransformRay(*instance, origin, direction, localOrigin, localDirection);
+
+			return instance->mesh->GetMeshBVH().RaycastAny(localOrigin, localDirection, closest) ? 0.0f : -1.0f;
+		};
+
+	std::uint32_t instanceID;
+	float distance;
+
+	return m_tlas.Raycast(origin, direction, maxDistance, hitTest, instanceID, distance);
+}
+
+std::uint32_t TwoLevelBVH::GetInstanceCount() const
+{
+	return m_instanceCount;
+}
+
+const BVH& TwoLevelBVH::GetTLAS() const
+{
+	return m_tlas;
+}
+
+const TwoLevelBVH::Instance* TwoLevelBVH::FindInstance(std::uint32_t instanceID) const
+{
+	std::uint32_t handleIndex = instanceID & BVH::HANDLE_INDEX_MASK;
+
+	if (handleIndex >= m_instances.size() || m_instances[handleIndex].mesh == nullptr)
+	{
+		return nullptr;
+	}
+
+	return &m_instances[handleIndex];
+}
+
+DirectX::BoundingBox TwoLevelBVH::CalculateWorldAABB(const MeshBVH& blas, const DirectX::XMFLOAT4X4& world)
+{
+	DirectX::BoundingBox worldAABB;
+	blas.GetBounds().Transform(worldAABB, DirectX::XMLoadFloat4x4(&world));
+
+	return worldAABB;
+}
+
+void TwoLevelBVH::TransformRay(const Instance& instance, const XMFLOAT3& origin, const XMFLOAT3& direction,
+	XMFLOAT3& outOrigin, XMFLOAT3& outDirection)
+{
+	DirectX::XMMATRIX inverseWorld = DirectX::XMLoadFloat4x4(&instance.inverseWorld);
+
+	DirectX::XMStoreFloat3(&outOrigin, DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&origin), inverseWorld));
+	DirectX::XMStoreFloat3(&outDirection, DirectX::XMVector3TransformNormal(DirectX::XMLoadFloat3(&direction), inverseWorld));
+}
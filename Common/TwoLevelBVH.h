@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <DirectXMath.h>
+
+#include "BVH.h"
+#include "MeshBVH.h"
+
+class StaticMeshData;
+
+struct SceneRayHit
+{
+	std::uint32_t instanceID = BVH::INVALID_ID;
+	// distance    ,  νϽ ޽ 
+	MeshRayHit meshHit;
+};
+
+//  Ʈ(TLAS) νϽ  AABB  BVH,  Ʈ(BLAS) StaticMeshData ϳ MeshBVH
+// ޸𸮴 νϽ  ƴ϶  ޽  ϰ, νϽ ̸ SetTransform + Update(Refit) ϸ 
+//  νϽ ķ ޽   Űܼ ˻ ( ȭ Ƿ Ÿ ״ )
+class TwoLevelBVH
+{
+private:
+	struct Instance
+	{
+		// BLAS  ȿ Ƿ νϽ   
+		std::shared_ptr<const StaticMeshData> mesh;
+		DirectX::XMFLOAT4X4 inverseWorld;
+	};
+
+	BVH m_tlas;
+	// TLAS Ʈ ID ڵ ε 
+	std::vector<Instance> m_instances;
+	std::uint32_t m_instanceCount = 0;
+	bool m_isDirty = false;
+
+public:
+	// world   (̴ ѱ  Transpose  ) . ȯ νϽ ID
+	std::uint32_t AddInstance(std::shared_ptr<const StaticMeshData> mesh, const DirectX::XMFLOAT4X4& world);
+	bool RemoveInstance(std::uint32_t instanceID);
+	void SetTransform(std::uint32_t instanceID, const DirectX::XMFLOAT4X4& world);
+
+	// νϽ Ѳ ߰    ȣؼ TLAS SAH ٽ 
+	void Rebuild();
+	//  νϽ  TLAS Refit.   ȣ
+	void Update();
+
+	bool Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, SceneRayHit& outHit) const;
+	bool RaycastAny(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance) const;
+
+	std::uint32_t GetInstanceCount() const;
+	const BVH& GetTLAS() const;
+
+private:
+	const Instance* FindInstance(std::uint32_t instanceID) const;
+	static DirectX::BoundingBox CalculateWorldAABB(const MeshBVH& blas, const DirectX::XMFLOAT4X4& world);
+	//   νϽ  
+	static void TransformRay(const Instance& instance, const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+		DirectX::XMFLOAT3& outOrigin, DirectX::XMFLOAT3& outDirection);
+};
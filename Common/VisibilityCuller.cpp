@@ -0,0 +1,105 @@
+#include "VisibilityCuller.h"
+
+void VisibleList::Clear()
+{
+	meshes.clear();
+	sectionIndices.clear();
+}
+
+void VisibilityCuller::Clear()
+{
+	m_meshBounds.clear();
+	m_firstSections.clear();
+	m_sectionBounds.clear();
+}
+
+void VisibilityCuller::AddMesh(const std::vector<DirectX::BoundingBox>& sectionWorldBounds)
+{
+	DirectX::BoundingBox meshBounds;
+
+	if (!sectionWorldBounds.empty())
+	{
+		meshBounds = sectionWorldBounds[0];
+
+		for (size_t i = 1; i < sectionWorldBounds.size(); ++i)
+		{
+			DirectX::BoundingBox::CreateMerged(meshBounds, meshBounds, sectionWorldBounds[i]);
+		}
+	}
+
+	m_meshBounds.push_back(meshBounds);
+	m_firstSections.push_back(static_cast<std::uint32_t>(m_sectionBounds.size()));
+	m_sectionBounds.insert(m_sectionBounds.end(), sectionWorldBounds.begin(), sectionWorldBounds.end());
+}
+
+void VisibilityCuller::Cull(const DirectX::BoundingFrustum& frustum, VisibleList& outList) const
+{
+	CullVolume(frustum, outList);
+}
+
+void VisibilityCuller::Cull(const DirectX::BoundingOrientedBox& volume, VisibleList& outList) const
+{
+	CullVolume(volume, outList);
+}
+
+std::uint32_t VisibilityCuller::GetMeshCount() const
+{
+	return static_cast<std::uint32_t>(m_meshBounds.size());
+}
+
+std::uint32_t VisibilityCuller::GetSectionCount() const
+{
+	return static_cast<std::uint32_t>(m_sectionBounds.size());
+}
+
+const DirectX::BoundingBox& VisibilityCuller::GetMeshBounds(std::uint32_t meshIndex) const
+{
+	return m_meshBounds[meshIndex];
+}
+
+template<typename Volume>
+void VisibilityCuller::CullVolume(const Volume& volume, VisibleList& outList) const
+{
+	outList.Clear();
+
+	const std::uint32_t meshCount = GetMeshCount();
+
+	for (std::uint32_t meshIndex = 0; meshIndex < meshCount; ++meshIndex)
+	{
+		const std::uint32_t firstSection = m_firstSections[meshIndex];
+		const std::uint32_t endSection = meshIndex + 1 < meshCount ? m_firstSections[meshIndex + 1] : GetSectionCount();
+
+		if (firstSection == endSection)
+		{
+			continue;
+		}
+
+		DirectX::ContainmentType containment = volume.Contains(m_meshBounds[meshIndex]);
+		if (containment == DirectX::DISJOINT)
+		{
+			continue;
+		}
+
+		VisibleMesh visibleMesh{ meshIndex, static_cast<std::uint32_t>(outList.sectionIndices.size()), 0 };
+
+		// ° ȿ ְų  ϳ̸  ˻ 
+		const bool testSections = containment == DirectX::INTERSECTS && endSection - firstSection > 1;
+
+		for (std::uint32_t i = firstSection; i < endSection; ++i)
+		{
+			if (testSections && !volume.Intersects(m_sectionBounds[i]))
+			{
+				continue;
+			}
+
+			outList.sectionIndices.push_back(i - firstSection);
+		}
+
+		visibleMesh.sectionCount = static_cast<std::uint32_t>(outList.sectionIndices.size()) - visibleMesh.firstSection;
+
+		if (visibleMesh.sectionCount > 0)
+		{
+			outList.meshes.push_back(visibleMesh);
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <DirectXCollision.h>
+
+// ø  ޽ ϳ. ׸  ȣ VisibleList::sectionIndices[firstSection, firstSection + sectionCount)
+struct VisibleMesh
+{
+	std::uint32_t meshIndex;
+	std::uint32_t firstSection;
+	std::uint32_t sectionCount;
+};
+
+// н ϳ ׸ ͸  . ޽   ״ 
+struct VisibleList
+{
+	std::vector<VisibleMesh> meshes;
+	std::vector<std::uint32_t> sectionIndices;
+
+	void Clear();
+};
+
+//   ޽/  AABB Ƶΰ ī޶, Ʈ ü ̴  ̾
+// ޽ AABB  ɷ, ü 迡 ģ ޽ø   ٽ ˻
+class VisibilityCuller
+{
+private:
+	std::vector<DirectX::BoundingBox> m_meshBounds;
+	// ޽ø m_sectionBounds  ġ.   ޽  ġ
+	std::vector<std::uint32_t> m_firstSections;
+	std::vector<DirectX::BoundingBox> m_sectionBounds;
+
+public:
+	void Clear();
+	// ޽ ε  . ޽ AABB  AABB ļ 
+	void AddMesh(const std::vector<DirectX::BoundingBox>& sectionWorldBounds);
+
+	void Cull(const DirectX::BoundingFrustum& frustum, VisibleList& outList) const;
+	//   (ĳ̵  )
+	void Cull(const DirectX::BoundingOrientedBox& volume, VisibleList& outList) const;
+
+	std::uint32_t GetMeshCount() const;
+	std::uint32_t GetSectionCount() const;
+	const DirectX::BoundingBox& GetMeshBounds(std::uint32_t meshIndex) const;
+
+private:
+	template<typename Volume>
+	void CullVolume(const Volume& volume, VisibleList& outList) const;
+};